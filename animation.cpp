@@ -1,5 +1,18 @@
 #include "animation.hpp"
 
+#include <algorithm>
+
+/*----------------------------------------------------------
+ * Animation
+ *--------------------------------------------------------*/
+
+double Animation::progress() const
+{
+    if (duration <= std::chrono::milliseconds::zero())
+        return 1;
+    return std::min(1.0, std::chrono::duration<double>(elapsed) / duration);
+}
+
 /*----------------------------------------------------------
  * StillAnimation
  *--------------------------------------------------------*/
@@ -7,7 +20,7 @@
 void StillAnimation::draw()
 {
     if (drawable) {
-        ++elapsed;
+        advance();
         drawable->draw();
     }
 }
@@ -19,7 +32,7 @@ void StillAnimation::draw()
 double ScaleAnimation::currentScale() const
 {
     if (!isComplete())
-        return 1-(0.95/duration * elapsed);
+        return 1-0.95*progress();
     else
         return 0;
 }
@@ -27,7 +40,7 @@ double ScaleAnimation::currentScale() const
 void ScaleAnimation::draw()
 {
     if (drawable) {
-        ++elapsed;
+        advance();
         Scale s{drawable->getCenter(), currentScale()};
         drawable->draw();
     }
@@ -40,8 +53,15 @@ void ScaleAnimation::draw()
 Point MoveAnimation::currentTranslation() const
 {
     if (!isComplete()) {
-        double x = (end.x-start.x)/static_cast<double>(duration) * elapsed;
-        double y = (end.y-start.y)/static_cast<double>(duration) * elapsed;
+        // Which part of the way, and how far along it
+        double progress = Animation::progress() * static_cast<double>(path.size()-1);
+        std::size_t part = std::min(static_cast<std::size_t>(progress), path.size()-2);
+        double along = progress - static_cast<double>(part);
+
+        Point from = path[part];
+        Point to = path[part+1];
+        double x = from.x-start.x + (to.x-from.x)*along;
+        double y = from.y-start.y + (to.y-from.y)*along;
         return {static_cast<int>(x), static_cast<int>(y)};
     }
     else
@@ -51,7 +71,7 @@ Point MoveAnimation::currentTranslation() const
 void MoveAnimation::draw()
 {
     if (drawable) {
-        ++elapsed;
+        advance();
         drawable->setCenter(getStart()+currentTranslation());
         /* Translation t{ currentTranslation() }; */
         drawable->draw();
@@ -65,7 +85,7 @@ void MoveAnimation::draw()
 double PulseAnimation::currentScale()
 {
     if (!isComplete())
-        return 1 + std::sin(std::numbers::pi*(static_cast<double>(elapsed)/duration))/4;
+        return 1 + std::sin(std::numbers::pi*progress())/4;
     else
         return 0;
 }
@@ -73,7 +93,7 @@ double PulseAnimation::currentScale()
 void PulseAnimation::draw()
 {
     if (drawable) {
-        ++elapsed;
+        advance();
         Scale s{drawable->getCenter(), currentScale()};
         drawable->draw();
     }
@@ -2,9 +2,12 @@
 #define ANIMATION_HPP
 
 #include <FL/fl_draw.H>
+#include <chrono>
 #include <iostream>
 #include <memory>
+#include <vector>
 
+#include "frame_clock.hpp"
 #include "point.hpp"
 #include "shape.hpp"
 
@@ -48,6 +51,13 @@ struct Rotation {
     }
 };
 
+/// Whether the current transformation only moves what is drawn
+inline bool onlyTranslated()
+{
+    return fl_transform_dx(1, 0) == 1 && fl_transform_dy(1, 0) == 0
+        && fl_transform_dx(0, 1) == 0 && fl_transform_dy(0, 1) == 1;
+}
+
 /*----------------------------------------------------------
  * Animations
  *--------------------------------------------------------*/
@@ -67,15 +77,24 @@ enum class AnimationT
  * animations and tie them to drawables after their
  * creation. The timers will start decreasing the moment
  * the animations are tied.
+ *
+ * Durations are in milliseconds, each draw moves the
+ * animation forward by the time of the last frame (see
+ * FrameClock) whatever the frame rate.
  */
 class Animation
 {
     protected:
         std::shared_ptr<AnimatableShape> drawable;
-        int elapsed = 0;
-        int duration;
+        FrameClock::Duration elapsed {0};
+        std::chrono::milliseconds duration;
+
+        void advance() { elapsed += FrameClock::delta(); }
+
+        /// Part of the duration elapsed, from 0 to 1
+        double progress() const;
     public:
-        Animation(int duration, std::shared_ptr<AnimatableShape> drawable = nullptr) noexcept
+        Animation(std::chrono::milliseconds duration, std::shared_ptr<AnimatableShape> drawable = nullptr) noexcept
             : drawable{drawable}, duration{duration} { }
 
         Animation(const Animation& a) = delete;
@@ -107,7 +126,7 @@ class Animation
 class StillAnimation : public Animation
 {
     public:
-        StillAnimation(int duration, std::shared_ptr<AnimatableShape> drawable = nullptr) noexcept
+        StillAnimation(std::chrono::milliseconds duration, std::shared_ptr<AnimatableShape> drawable = nullptr) noexcept
             : Animation{duration, drawable} { }
 
         void draw() override;
@@ -128,7 +147,7 @@ class ScaleAnimation : public Animation
     private:
         double currentScale() const;
     public:
-        ScaleAnimation(int duration, std::shared_ptr<AnimatableShape> drawable = nullptr) noexcept
+        ScaleAnimation(std::chrono::milliseconds duration, std::shared_ptr<AnimatableShape> drawable = nullptr) noexcept
             : Animation{duration, drawable} { }
 
         void draw() override;
@@ -138,20 +157,32 @@ class ScaleAnimation : public Animation
 /**
  * Animation played when an object is moved from a to b
  *
+ * The object can also go through several points on its way,
+ * spending the same time between each of them.
+ *
  * @param drawable pointer to the drawable that has the animation
  * @param duration time during which the animation is active
  * @param start begining point
  * @param end finishing point
+ * @param waypoints every point of the way, start and end included
  */
 class MoveAnimation : public Animation
 {
     private:
         Point start;
         Point end;
+        std::vector<Point> path;
         Point currentTranslation() const;
     public:
-        MoveAnimation(int duration, Point start, Point end, std::shared_ptr<AnimatableShape> drawable=nullptr) noexcept
-            : Animation{duration, drawable}, start{start}, end{end} { }
+        MoveAnimation(std::chrono::milliseconds duration, Point start, Point end, std::shared_ptr<AnimatableShape> drawable=nullptr)
+            : MoveAnimation{duration, std::vector<Point>{start, end}, drawable} { }
+
+        MoveAnimation(std::chrono::milliseconds duration, std::vector<Point> waypoints, std::shared_ptr<AnimatableShape> drawable=nullptr) noexcept
+            : Animation{duration, drawable},
+              start{waypoints.front()},
+              end{waypoints.back()},
+              path{std::move(waypoints)}
+        { }
 
         void draw() override;
         AnimationT type() const override { return AnimationT::MoveAnimation; }
@@ -168,7 +199,7 @@ class PulseAnimation : public Animation
     private:
         double currentScale();
     public:
-        PulseAnimation(int duration, std::shared_ptr<AnimatableShape> drawable=nullptr) noexcept
+        PulseAnimation(std::chrono::milliseconds duration, std::shared_ptr<AnimatableShape> drawable=nullptr) noexcept
             : Animation{duration, drawable}
         {
         }
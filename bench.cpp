@@ -0,0 +1,254 @@
+/*
+ * Times the inner loops of the game on fixed boards
+ *
+ * Each benchmark runs the headless counterpart of a function of the
+ * states, and is named after what it runs, the state it stands for
+ * being noted next to it. It runs on boards of every size from 3 to 26
+ * filled from a fixed seed, and prints the time and the number of allocations
+ * per call. Only the calls are measured, the copies of the boards they
+ * play on are made beforehand.
+ *
+ * Usage: bench.out [filter]
+ *  - filter  only runs the benchmarks whose name contains it
+ *
+ * Numbers are only worth comparing between builds with the same flags,
+ * e.g. make clean && make DEBUG=-O2 bench.out
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "bitboard.hpp"
+#include "board.hpp"
+#include "board_engine.hpp"
+#include "move_finder.hpp"
+#include "point.hpp"
+
+/*----------------------------------------------------------
+ * Allocation counter
+ *--------------------------------------------------------*/
+
+namespace {
+std::size_t allocations {0};  // the benchmarks run on a single thread
+}
+
+void *operator new(std::size_t size)
+{
+    ++allocations;
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+/*----------------------------------------------------------
+ * Fixtures
+ *--------------------------------------------------------*/
+
+constexpr std::uint64_t benchSeed {2022};
+constexpr int colorRange {6};
+constexpr int minSide {3};
+constexpr int maxSide {Board::maxSide};
+
+/// Board with standard candies only and no combination
+Board candies(int side)
+{
+    Board ret {side, side, colorRange};
+    BoardEngine{ret, benchSeed}.fillEmptyCells();
+    return ret;
+}
+
+/// Board with a combination on the first row
+Board withCombination(int side)
+{
+    Board ret {candies(side)};
+    for (int x = 1; x<3; ++x)
+        ret.at({x, 0}).color = ret.at({0, 0}).color;
+    return ret;
+}
+
+/// Board with an empty row in the middle
+Board withHoles(int side)
+{
+    Board ret {candies(side)};
+    for (int x = 0; x<side; ++x)
+        ret.at({x, side/2}) = Tile{};
+    return ret;
+}
+
+/// Board with a colour bomb next to a candy
+Board withColourBomb(int side)
+{
+    Board ret {candies(side)};
+    ret.at({0, 0}) = Tile{};
+    ret.at({0, 0}).type = ContentT::ColourBomb;
+    return ret;
+}
+
+/// A board to play on and its engine
+struct Played
+{
+    Board board;
+    BoardEngine engine;
+
+    explicit Played(const Board &b)
+        : board{b}, engine{board, benchSeed}
+    { }
+};
+
+/*----------------------------------------------------------
+ * Measure
+ *--------------------------------------------------------*/
+
+struct Measure
+{
+    double ns {0};      // per call
+    double allocs {0};  // per call
+};
+
+constexpr std::size_t batchSize {64};
+constexpr std::chrono::milliseconds minTime {10};
+
+/**
+ * Calls run on batches of states made by make
+ * until it ran for at least minTime
+ */
+template<typename Make, typename Run>
+Measure measure(Make make, Run run)
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<decltype(make())> batch;
+    batch.reserve(batchSize);
+
+    Clock::duration elapsed {0};
+    std::size_t calls {0};
+    std::size_t allocated {0};
+    while (elapsed < minTime) {
+        batch.clear();
+        for (std::size_t i = 0; i<batchSize; ++i)
+            batch.push_back(make());
+
+        std::size_t before {allocations};
+        auto start {Clock::now()};
+        for (auto &state: batch)
+            run(state);
+        elapsed += Clock::now() - start;
+        allocated += allocations - before;
+        calls += batchSize;
+    }
+
+    auto ns {std::chrono::duration<double, std::nano>(elapsed).count()};
+    return {ns / static_cast<double>(calls),
+            static_cast<double>(allocated) / static_cast<double>(calls)};
+}
+
+/// Calls run with each point of the board in turn
+template<typename Run>
+Measure measureCells(const Board &board, Run run)
+{
+    int next {0};
+    return measure([&]() { return board.pointOf(next++ % board.size()); }, run);
+}
+
+/*----------------------------------------------------------
+ * Benchmarks
+ *--------------------------------------------------------*/
+
+struct Benchmark
+{
+    std::string name;
+    Measure (*run)(int side);
+};
+
+const std::vector<Benchmark> benchmarks {
+    // MatchState::getCombinationContaining, with each finder
+    {"Board::getCombinationContaining", [](int side) {
+        Board board {candies(side)};
+        return measureCells(board, [&](const Point &p) {
+                board.getCombinationContaining(p);
+                });
+    }},
+    {"BitBoard::getCombinationContaining", [](int side) {
+        Board board {candies(side)};
+        BitBoard bits {board};
+        return measureCells(board, [&](const Point &p) {
+                bits.getCombinationContaining(p, true);
+                });
+    }},
+    // Grid::snapshot
+    {"Board copy", [](int side) {
+        Board board {candies(side)};
+        return measure([&]() { return Board{side, side, colorRange}; },
+                [&](Board &copy) { copy = board; });
+    }},
+    // MatchState::processCombinationContaining
+    {"BoardEngine::processCombinationContaining", [](int side) {
+        Board board {withCombination(side)};
+        return measure([&]() { return std::make_unique<Played>(board); },
+                [](auto &played) { played->engine.processCombinationContaining({0, 0}); });
+    }},
+    // FallState::fillGrid
+    {"BoardEngine::fillGrid", [](int side) {
+        Board board {withHoles(side)};
+        return measure([&]() { return std::make_unique<Played>(board); },
+                [](auto &played) { played->engine.fillGrid(); });
+    }},
+    // GridInitState::fillEmptyCells
+    {"BoardEngine::fillEmptyCells", [](int side) {
+        Board board {side, side, colorRange};
+        return measure([&]() { return std::make_unique<Played>(board); },
+                [](auto &played) { played->engine.fillEmptyCells(); });
+    }},
+    // ReadyState::getBestCombination
+    {"MoveFinder::best", [](int side) {
+        Board board {candies(side)};
+        BitBoard bits {board};
+        return measure([]() { return 0; },
+                [&](int) { MoveFinder{bits}.best(); });
+    }},
+    // ColourBomb::replaceAndExplode
+    {"BoardEngine::swap (colour bomb)", [](int side) {
+        Board board {withColourBomb(side)};
+        return measure([&]() { return std::make_unique<Played>(board); },
+                [](auto &played) { played->engine.swap({0, 0}, {1, 0}); });
+    }},
+};
+
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    std::string filter {argc > 1 ? argv[1] : ""};
+
+    std::cout << std::left << std::setw(50) << "benchmark"
+        << std::right << std::setw(6) << "size"
+        << std::setw(14) << "ns/op"
+        << std::setw(12) << "allocs/op" << "\n";
+
+    for (auto &b: benchmarks) {
+        if (b.name.find(filter) == std::string::npos)
+            continue;
+
+        for (int side = minSide; side<=maxSide; ++side) {
+            Measure m {b.run(side)};
+            std::cout << std::left << std::setw(50) << b.name
+                << std::right << std::setw(6) << side
+                << std::fixed << std::setprecision(1) << std::setw(14) << m.ns
+                << std::setprecision(2) << std::setw(12) << m.allocs << "\n";
+        }
+    }
+
+    return 0;
+}
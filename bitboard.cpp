@@ -0,0 +1,173 @@
+#include "bitboard.hpp"
+
+#include <bit>
+#include <cassert>
+
+/*----------------------------------------------------------
+ * BitBoard
+ *--------------------------------------------------------*/
+
+BitBoard::BitBoard(int rows, int columns)
+    :
+        rows{rows},
+        columns{columns}
+{
+    assert(rows <= maxSide && columns <= maxSide);
+}
+
+BitBoard::BitBoard(const Board &board)
+    : BitBoard{board.rowCount(), board.colCount()}
+{
+    refresh(board);
+}
+
+void BitBoard::refresh(const Point &p, const Tile &t)
+{
+    const std::uint32_t xBit {std::uint32_t{1} << p.x};
+    const std::uint32_t yBit {std::uint32_t{1} << p.y};
+    for (unsigned c = 0; c<colorCount; ++c) {
+        m_rows[c][static_cast<unsigned>(p.y)] &= ~xBit;
+        m_cols[c][static_cast<unsigned>(p.x)] &= ~yBit;
+    }
+
+    if (t.isMatchable() && !t.has(Tile::Clearing)) {
+        auto c {static_cast<unsigned>(t.color)};
+        m_rows[c][static_cast<unsigned>(p.y)] |= xBit;
+        m_cols[c][static_cast<unsigned>(p.x)] |= yBit;
+    }
+}
+
+void BitBoard::refresh(const Board &board)
+{
+    assert(board.rowCount() == rows && board.colCount() == columns);
+    m_rows = {};
+    m_cols = {};
+    for (int i = 0; i<board.size(); ++i) {
+        Point p {board.pointOf(i)};
+        refresh(p, board.at(p));
+    }
+}
+
+int BitBoard::colorAt(const Point &p) const
+{
+    for (int c = 0; c<colorCount; ++c)
+        if (rowMask(c, p.y) >> p.x & 1)
+            return c;
+    return -1;
+}
+
+/**
+ * The length of the run going from p to the east is the number
+ * of trailing ones of the row shifted by x, the one going to the
+ * west the number of leading ones of the row shifted the other
+ * way. Same for north and south with the column.
+ */
+auto BitBoard::armsOf(const Point &p, int color) const -> Arms
+{
+    const std::uint32_t row {m_rows[static_cast<unsigned>(color)][static_cast<unsigned>(p.y)]};
+    const std::uint32_t col {m_cols[static_cast<unsigned>(color)][static_cast<unsigned>(p.x)]};
+    return {
+        std::countr_one(row >> p.x) - 1,
+        std::countr_one(col >> p.y) - 1,
+        std::countl_one(row << (maxSide-1 - p.x)) - 1,
+        std::countl_one(col << (maxSide-1 - p.y)) - 1
+    };
+}
+
+/**
+ * See Board::getCombinationContaining
+ *
+ * The best combination is chosen from the lengths of the runs
+ * crossing each element, in the order the walker tries them, and
+ * only that one is built.
+ */
+Combination BitBoard::getCombinationContaining(const Point &origin, bool rec) const
+{
+    int c {colorAt(origin)};
+    if (c == -1)
+        return Combination{origin};
+
+    Point best {origin};
+    Arms arms {armsOf(origin, c)};
+    if (rec) {
+        const Arms around {arms};
+        int bestTotal {arms.total()};
+        auto consider = [&](const Point &p) {
+            const Arms a {armsOf(p, c)};
+            if (a.total() > bestTotal) {
+                bestTotal = a.total();
+                best = p;
+                arms = a;
+            }
+        };
+
+        // Same order as Combination::getAllElements
+        for (int i = 1; i<=around.north; ++i)
+            consider({origin.x, origin.y+i});
+        for (int i = 1; i<=around.south; ++i)
+            consider({origin.x, origin.y-i});
+        for (int i = 1; i<=around.east; ++i)
+            consider({origin.x+i, origin.y});
+        for (int i = 1; i<=around.west; ++i)
+            consider({origin.x-i, origin.y});
+    }
+
+    // Same order as the walker
+    Combination ret{best};
+    for (int i = 1; i<=arms.east; ++i)
+        ret.addHorizontalElement({best.x+i, best.y});
+    for (int i = 1; i<=arms.north; ++i)
+        ret.addVerticalElement({best.x, best.y+i});
+    for (int i = 1; i<=arms.west; ++i)
+        ret.addHorizontalElement({best.x-i, best.y});
+    for (int i = 1; i<=arms.south; ++i)
+        ret.addVerticalElement({best.x, best.y-i});
+    return ret;
+}
+
+/**
+ * See Board::isInCombination
+ *
+ * Being part of a run of 3 is enough, a better combination found
+ * from another element keeps a run of 3 or more. Otherwise the
+ * best combination of a neighbour of the same color may still
+ * have one, like with the walker.
+ */
+bool BitBoard::isInCombination(const Point &p) const
+{
+    if (matchedInRow(p.y) >> p.x & 1)
+        return true;
+
+    auto combi {getCombinationContaining(p)};
+    return combi.getVerticalCount() >= 3
+        || combi.getHorizontalCount() >= 3;
+}
+
+std::uint32_t BitBoard::matchedInRow(int y) const
+{
+    std::uint32_t ret {0};
+    for (int c = 0; c<colorCount; ++c) {
+        const std::uint32_t r {rowMask(c, y)};
+
+        // Starts of horizontal runs of 3, then the cells they cover
+        std::uint32_t h {r & r>>1 & r>>2};
+        h |= h<<1 | h<<2;
+
+        // Vertical runs of 3 covering row y, which is at their bottom, middle or top
+        const std::uint32_t below {rowMask(c, y-1)};
+        const std::uint32_t above {rowMask(c, y+1)};
+        std::uint32_t v {(rowMask(c, y-2) & below) | (below & above) | (above & rowMask(c, y+2))};
+        v &= r;
+
+        ret |= h | v;
+    }
+    return ret;
+}
+
+bool BitBoard::hasCombination() const
+{
+    for (int y = 0; y<rows; ++y)
+        if (matchedInRow(y))
+            return true;
+    return false;
+}
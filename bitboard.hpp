@@ -0,0 +1,98 @@
+#ifndef BITBOARD_HPP
+#define BITBOARD_HPP
+
+#include <array>
+#include <cstdint>
+
+#include "board.hpp"
+#include "combination.hpp"
+#include "point.hpp"
+#include "tile.hpp"
+
+/**
+ * Algorithm used to find the combination containing a cell
+ */
+enum class MatchFinder {
+    Walker,     // walks the cells from the origin, see MatchState
+    Bitboard    // reads runs out of a BitBoard
+};
+
+/**
+ * Candies of a board stored as one bitmask per color and row
+ *
+ * Levels are at most 26x26, so a row (or a column) of a given
+ * color fits in 32 bits. Runs of candies are then found with
+ * shifts and ands instead of walking cells one by one.
+ *
+ * Only matchable candies that are not being cleared are set,
+ * like the walker which stops on anything else.
+ *
+ * Gives the same combinations as Board::getCombinationContaining,
+ * elements in the same order, so both can be diffed.
+ *
+ * @param board the board to read
+ */
+class BitBoard
+{
+    public:
+        static constexpr int maxSide {32};
+        static constexpr int colorCount {6};
+    private:
+        using Masks = std::array<std::array<std::uint32_t, maxSide>, colorCount>;
+
+        int rows;
+        int columns;
+        Masks m_rows {};  // m_rows[color][y], bit x set if the candy at (x, y) has that color
+        Masks m_cols {};  // m_cols[color][x], bit y set if the candy at (x, y) has that color
+
+        /// Lengths of the runs of a color going away from a cell, the cell aside
+        struct Arms
+        {
+            int east {0};
+            int north {0};
+            int west {0};
+            int south {0};
+
+            /// See Combination::getTotalCount
+            int total() const
+            {
+                const int h {1+east+west};
+                const int v {1+north+south};
+                return (h>2 ? h : 0) + (v>2 ? v : 0);
+            }
+        };
+
+        Arms armsOf(const Point &p, int color) const;
+    public:
+        BitBoard(int rows, int columns);
+        explicit BitBoard(const Board &board);
+
+        int rowCount() const { return rows; }
+        int colCount() const { return columns; }
+
+        /// Color index of the candy at p, -1 if none
+        int colorAt(const Point &p) const;
+
+        // Masks of a color, 0 outside of the board
+        std::uint32_t rowMask(int color, int y) const
+        {
+            return y>=0 && y<rows ? m_rows[static_cast<unsigned>(color)][static_cast<unsigned>(y)] : 0;
+        }
+        std::uint32_t colMask(int color, int x) const
+        {
+            return x>=0 && x<columns ? m_cols[static_cast<unsigned>(color)][static_cast<unsigned>(x)] : 0;
+        }
+
+        /// Reads the tile at p again, to be called when it changed
+        void refresh(const Point &p, const Tile &t);
+        void refresh(const Board &board);
+
+        Combination getCombinationContaining(const Point &p, bool rec = true) const;
+        bool isInCombination(const Point &p) const;
+
+        /// Cells of row y that are part of a run of 3 or more, in any axis
+        std::uint32_t matchedInRow(int y) const;
+        bool hasCombination() const;
+};
+
+#endif // BITBOARD_HPP
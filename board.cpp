@@ -0,0 +1,70 @@
+#include "board.hpp"
+
+#include <cassert>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable_v<Board>);
+
+/*----------------------------------------------------------
+ * Board
+ *--------------------------------------------------------*/
+
+Board::Board(int rows, int columns, int colorRange)
+    :
+        rows{rows},
+        columns{columns},
+        colorRange{colorRange}
+{
+    assert(rows>0 && rows<=maxSide && columns>0 && columns<=maxSide);
+}
+
+/**
+ * Whether the tile at b can be part of the same combination
+ * as the one at a. Clearing tiles are not matchable anymore.
+ */
+bool Board::hasMatchWith(const Point &a, const Point &b) const
+{
+    const Tile &t {at(a)};
+    const Tile &o {at(b)};
+    return t.matches(o) && !o.has(Tile::Clearing);
+}
+
+/**
+ * Combination containing the given point, see
+ * MatchState::getCombinationContaining for details.
+ */
+Combination Board::getCombinationContaining(const Point &origin, bool rec) const
+{
+    Combination ret{origin};
+
+    // Gather combination having origin as starting point
+    for (auto &direction: {Direction::East, Direction::North, Direction::West, Direction::South}) {
+        Point curr{origin};
+        Point next{origin + directionModifier[static_cast<unsigned>(direction)]};
+
+        while (isIndexValid(next) && hasMatchWith(curr, next)) {
+            curr = next;
+            ret.addElement(curr, direction);
+            next = Point{curr + directionModifier[static_cast<unsigned>(direction)]};
+        }
+    }
+
+    // Check wether it's the best combination containing origin
+    if (rec) {
+        for (auto &elem: ret.getAllElements()) {
+            auto tmp {getCombinationContaining(elem, false)};
+            if (tmp.getTotalCount() > ret.getTotalCount()) {
+                ret = tmp;
+            }
+        }
+    }
+
+    return ret;
+}
+
+bool Board::isInCombination(const Point &point) const
+{
+    auto combi = getCombinationContaining(point);
+    return combi.getVerticalCount() >= 3
+        || combi.getHorizontalCount() >= 3;
+}
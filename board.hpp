@@ -0,0 +1,76 @@
+#ifndef BOARD_HPP
+#define BOARD_HPP
+
+#include <array>
+
+#include "combination.hpp"
+#include "point.hpp"
+#include "tile.hpp"
+
+/**
+ * Pure logic model of a grid, no drawing involved
+ *
+ * The board is a plain row-major array of tiles. It knows
+ * nothing about FLTK, shapes or animations so it can be copied
+ * and played on as fast as the machine allows, e.g. to
+ * simulate games or search for moves.
+ *
+ * Same coordinate system as the Grid: (0, 0) is the
+ * bottom left cell, y grows to the north.
+ *
+ * The tiles are stored inline, room being made for the biggest
+ * grid a level can have. A board is then a plain value, trivially
+ * copyable: a copy is a single memcpy, with no allocation, which
+ * makes it the snapshot of a Grid (see Grid::snapshot).
+ *
+ * @param rows number of rows
+ * @param columns number of columns
+ * @param colorRange number of candy colors used by the level
+ */
+class Board
+{
+    public:
+        static constexpr int maxSide {26};
+    private:
+        int rows;
+        int columns;
+        int colorRange;
+        std::array<Tile, maxSide*maxSide> tiles {};
+
+        std::size_t indexOf(const Point &p) const
+        {
+            return static_cast<std::size_t>(p.y*columns + p.x);
+        }
+    public:
+        Board(int rows, int columns, int colorRange);
+
+        int rowCount() const { return rows; }
+        int colCount() const { return columns; }
+        int getColorRange() const { return colorRange; }
+
+        bool isIndexValid(const Point &p) const
+        {
+            return p.x>=0 && p.x<columns && p.y>=0 && p.y<rows;
+        }
+        bool isIndexValid(const Point &p, Direction d) const
+        {
+            return isIndexValid(p+directionModifier[static_cast<unsigned>(d)]);
+        }
+
+        Tile &at(const Point &p) { return tiles[indexOf(p)]; }
+        const Tile &at(const Point &p) const { return tiles[indexOf(p)]; }
+        Tile &at(const Point &p, Direction d) { return at(p+directionModifier[static_cast<unsigned>(d)]); }
+        const Tile &at(const Point &p, Direction d) const { return at(p+directionModifier[static_cast<unsigned>(d)]); }
+
+        /// Point of the i-th tile in row-major order
+        Point pointOf(int i) const { return {i%columns, i/columns}; }
+        int size() const { return rows*columns; }
+
+        bool hasMatchWith(const Point &a, const Point &b) const;
+
+        // Same rules as the ones of MatchState
+        Combination getCombinationContaining(const Point &p, bool rec = true) const;
+        bool isInCombination(const Point &p) const;
+};
+
+#endif // BOARD_HPP
@@ -0,0 +1,542 @@
+#include "board_engine.hpp"
+
+#include <cstdlib>
+#include <utility>
+
+#include "candy_generator.hpp"
+#include "gravity.hpp"
+
+/*----------------------------------------------------------
+ * BoardEngine
+ *--------------------------------------------------------*/
+
+void BoardEngine::put(const Point &p, ContentT type, CandyColor color, Axis axis)
+{
+    Tile &t {board.at(p)};
+    t = Tile{};
+    t.type = type;
+    t.color = color;
+    t.axis = axis;
+    m_changed.mark(p);
+
+    if (auto r {logged()}; r && t.isSpecial())
+        r->created.push_back({p, t});
+}
+
+// CLEARING
+
+/**
+ * Clears the content of a tile, triggering its effect
+ *
+ * @return whether the clearing process began
+ */
+bool BoardEngine::clearCell(const Point &p)
+{
+    Tile &t {board.at(p)};
+    t.set(Tile::Processed);
+    if (!t.isClearable() || t.has(Tile::Clearing))
+        return false;
+
+    switch (t.type) {
+        case ContentT::Icing:
+            removeLayer(p);
+            if (t.layers == 0)
+                t.set(Tile::Clearing);
+            break;
+        case ContentT::WrappedCandy:
+            // First phase, the second one comes at the end of the fall
+            t.set(Tile::Clearing);
+            t.set(Tile::Armed);
+            explode(p);
+            break;
+        default:
+            t.set(Tile::Clearing);
+            explode(p);
+            break;
+    }
+
+    if (auto r {logged()}; r && t.has(Tile::Clearing))
+        r->cleared.push_back(p);
+
+    m_score += 50;
+    notifyObservers(Event::CellCleared);
+    return true;
+}
+
+/**
+ * Clears the content with its effect and removes it at once
+ */
+void BoardEngine::clearCellWithoutAnimation(const Point &p)
+{
+    Tile &t {board.at(p)};
+    t.set(Tile::Processed);
+    if (t.isClearable() && !t.has(Tile::Clearing)) {
+        if (auto r {logged()})
+            r->cleared.push_back(p);
+        t.set(Tile::Clearing);
+        explode(p);
+        t = Tile{};
+        t.set(Tile::Processed);
+    }
+}
+
+/**
+ * Clears the content as if it were a standard candy
+ */
+void BoardEngine::clearWithoutEffect(const Point &p)
+{
+    if (auto r {logged()})
+        r->cleared.push_back(p);
+    board.at(p).set(Tile::Clearing);
+}
+
+void BoardEngine::removeLayer(const Point &p)
+{
+    Tile &t {board.at(p)};
+    if (t.layers > 0) {
+        --t.layers;
+        if (auto r {logged()})
+            r->icingRemoved.push_back(p);
+        notifyObservers(Event::IcingCleared);
+    }
+}
+
+/**
+ * Effect of a special candy, the tile should already be clearing
+ */
+void BoardEngine::explode(const Point &p)
+{
+    const Tile &t {board.at(p)};
+    switch (t.type) {
+        case ContentT::StripedCandy:
+            if (t.axis == Axis::Horizontal)
+                clearRow(p.y);
+            else
+                clearColumn(p.x);
+            break;
+        case ContentT::WrappedCandy:
+            clearSquare(p, t.has(Tile::DoubleWrapped) ? 2 : 1);
+            break;
+        case ContentT::ColourBomb:
+            replaceAndExplode(static_cast<CandyColor>(m_random.below(6)), ContentT::StandardCandy);
+            break;
+        default:
+            break;
+    }
+}
+
+// Lines out of the board are empty, see BoardGeometry
+
+void BoardEngine::clearRow(int y)
+{
+    for (auto &p: m_geometry.row(y))
+        clearCell(p);
+}
+
+void BoardEngine::clearColumn(int x)
+{
+    for (auto &p: m_geometry.column(x))
+        clearCell(p);
+}
+
+void BoardEngine::clearSquare(const Point &center, int radius)
+{
+    for (auto &p: m_geometry.square(center, radius))
+        clearCell(p);
+}
+
+/**
+ * See ColourBomb::replaceAndExplode
+ */
+void BoardEngine::replaceAndExplode(CandyColor color, ContentT replaceWith)
+{
+    // case other is a ColourBomb
+    if (replaceWith == ContentT::ColourBomb) {
+        for (int i = 0; i<board.size(); ++i)
+            clearCell(board.pointOf(i));
+        return;
+    }
+
+    // case other is standard, striped or wrapped
+    for (int i = 0; i<board.size(); ++i) {
+        Point p {board.pointOf(i)};
+        const Tile &t {board.at(p)};
+        if (t.type == ContentT::StandardCandy && t.color == color && !t.has(Tile::Clearing)) {
+            put(p, replaceWith, color, m_random.coin() ? Axis::Horizontal : Axis::Vertical);
+            board.at(p).set(Tile::Processed);
+        }
+    }
+
+    for (int i = 0; i<board.size(); ++i) {
+        Point p {board.pointOf(i)};
+        if (board.at(p).isCandy() && board.at(p).color == color)
+            clearCell(p);
+    }
+}
+
+// COMBINATIONS
+
+/**
+ * Combination containing p, found by the selected MatchFinder
+ *
+ * The bitboard is read again from the board only when it is
+ * stale, that is after a combination was processed or when
+ * swap and fallEnd start looking for combinations.
+ */
+Combination BoardEngine::combinationContaining(const Point &p)
+{
+    if (m_finder == MatchFinder::Walker)
+        return board.getCombinationContaining(p);
+
+    if (m_bitsStale) {
+        m_bits.refresh(board);
+        m_bitsStale = false;
+    }
+    return m_bits.getCombinationContaining(p);
+}
+
+/**
+ * See MatchState::processCombinationContaining
+ */
+bool BoardEngine::processCombinationContaining(const Point &elem)
+{
+    const Tile &t {board.at(elem)};
+    if (t.has(Tile::Clearing) || t.has(Tile::Processed))
+        return false;
+
+    auto combi {combinationContaining(elem)};
+    bool oneCombination {true};
+
+    Point origin {combi.getOrigin()};
+    std::size_t vc = combi.getVerticalCount();
+    std::size_t hc = combi.getHorizontalCount();
+    CandyColor color {board.at(origin).color};
+
+    auto largestDirection {hc>vc ? combi.getHorizontalElements() : combi.getVerticalElements()};
+
+    switch (combi.type()) {
+        case CombinationT::Line3:
+            clearCell(origin);
+            for (auto &p: largestDirection)
+                clearCell(p);
+            m_score += 50;
+            break;
+        case CombinationT::Line4:
+            clearCellWithoutAnimation(origin);
+            for (auto &p: largestDirection)
+                clearCell(p);
+            put(origin, ContentT::StripedCandy, color, vc<hc ? Axis::Vertical : Axis::Horizontal);
+            board.at(origin).set(Tile::Processed);
+            m_score += 125;
+            break;
+        case CombinationT::Cross:
+            clearCellWithoutAnimation(origin);
+            for (auto &p: combi.getAllElements())
+                clearCell(p);
+            put(origin, ContentT::WrappedCandy, color, Axis::Vertical);
+            board.at(origin).set(Tile::Processed);
+            m_score += 200;
+            break;
+        case CombinationT::Line5:
+            clearCellWithoutAnimation(origin);
+            for (auto &p: largestDirection)
+                clearCell(p);
+            put(origin, ContentT::ColourBomb, CandyColor{}, Axis::Vertical);  // has no colour, see ColourBomb
+            board.at(origin).set(Tile::Processed);
+            m_score += 500;
+            break;
+        default:
+            oneCombination = false;
+            break;
+    }
+
+    if (oneCombination) {
+        notifyNeighboursMatched(combi);
+        m_bitsStale = true;
+    }
+
+    return oneCombination;
+}
+
+/**
+ * Icings next to a combination lose a layer, see Icing::update
+ */
+void BoardEngine::notifyNeighboursMatched(const Combination &combi)
+{
+    auto vec{ combi.getAllElements() };
+    vec.push_back(combi.getOrigin());
+
+    for (auto &c: vec) {
+        for (auto &n: m_geometry.neighboursOf(c)) {
+            Tile &t {board.at(n)};
+            if (t.type == ContentT::Icing && t.layers > 0 && !t.has(Tile::Clearing)) {
+                removeLayer(n);
+                if (t.layers == 0) {
+                    t.set(Tile::Clearing);
+                    if (auto r {logged()})
+                        r->cleared.push_back(n);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Whether contents are being cleared, i.e. the equivalent of
+ * clearing animations playing on the Grid.
+ */
+bool BoardEngine::isWaiting() const
+{
+    for (int i = 0; i<board.size(); ++i) {
+        const Tile &t {board.at(board.pointOf(i))};
+        if (t.has(Tile::Clearing) && !t.has(Tile::Armed))
+            return true;
+    }
+    return false;
+}
+
+/**
+ * See ClearState, armed wrapped candies stay on the board
+ */
+void BoardEngine::removeCleared()
+{
+    for (int i = 0; i<board.size(); ++i) {
+        Tile &t {board.at(board.pointOf(i))};
+        if (t.has(Tile::Clearing) && !t.has(Tile::Armed))
+            t = Tile{};
+    }
+}
+
+// START
+
+/**
+ * Puts standard candies in empty tiles, none of them
+ * being part of a combination
+ */
+void BoardEngine::fillEmptyCells()
+{
+    CandyGenerator{board, m_random}.fillEmpty();
+
+    // Nothing to look at when the first fall ends, see ReadyState
+    m_changed.clear();
+    m_bitsStale = true;
+}
+
+// FALLING
+
+/**
+ * Everything falls to where it comes to rest, see FallState::fillGrid
+ *
+ * @return whether anything fell
+ */
+bool BoardEngine::fillGrid()
+{
+    auto falls {Gravity{board, m_random}.settle()};
+    for (auto &f: falls)
+        m_changed.mark(f.path.back());
+
+    bool hasFallen {!falls.empty()};
+    if (hasFallen)
+        m_bitsStale = true;
+    if (auto r {logged()})
+        r->falls = std::move(falls);
+    return hasFallen;
+}
+
+/**
+ * Nothing falls anymore, armed wrapped candies explode a second
+ * time and new combinations are processed among the tiles that
+ * were filled.
+ */
+void BoardEngine::fallEnd()
+{
+    for (int i = 0; i<board.size(); ++i)
+        board.at(board.pointOf(i)).unset(Tile::Processed);
+
+    for (int i = 0; i<board.size(); ++i) {
+        Point p {board.pointOf(i)};
+        if (board.at(p).has(Tile::Armed)) {
+            board.at(p).unset(Tile::Armed);
+            explode(p);
+        }
+    }
+
+    // The combination found from p may be one next to it, p is
+    // then looked at again until it is cleared or in none
+    m_bitsStale = true;
+    for (auto &p: m_changed.take())
+        while (processCombinationContaining(p)) { }
+}
+
+// TURN
+
+/**
+ * Whether swapping a and b has an effect even if it makes no
+ * combination, see swapEffect
+ */
+bool BoardEngine::isSpecialSwap(const Tile &a, const Tile &b)
+{
+    auto stripedOrWrapped = [](const Tile &t) {
+        return t.type == ContentT::StripedCandy || t.type == ContentT::WrappedCandy;
+    };
+
+    if (a.type == ContentT::ColourBomb)
+        return b.isCandy() || b.type == ContentT::ColourBomb;
+    if (b.type == ContentT::ColourBomb)
+        return a.isCandy();
+    return stripedOrWrapped(a) && stripedOrWrapped(b);
+}
+
+/**
+ * Effect of swapping the content at p with the one at other,
+ * see wasSwappedWith of the candies.
+ */
+void BoardEngine::swapEffect(const Point &p, const Point &other)
+{
+    Tile &t {board.at(p)};
+    Tile &o {board.at(other)};
+
+    if (t.type == ContentT::ColourBomb && !t.has(Tile::Clearing)) {
+        if (o.isCandy()) {
+            t.set(Tile::Clearing);
+            replaceAndExplode(o.color, o.type);
+        } else if (o.type == ContentT::ColourBomb) {
+            t.set(Tile::Clearing);
+            replaceAndExplode(o.color, ContentT::ColourBomb);
+        }
+        return;
+    }
+
+    bool otherSpecial {o.type == ContentT::StripedCandy || o.type == ContentT::WrappedCandy};
+    if (!otherSpecial || t.has(Tile::Clearing))
+        return;
+
+    if (t.type == ContentT::StripedCandy) {
+        clearWithoutEffect(other);
+        t.set(Tile::Clearing);
+        if (o.type == ContentT::StripedCandy) {
+            clearRow(p.y);
+            clearColumn(p.x);
+        } else {
+            for (int d = -1; d <= 1; ++d) {
+                clearColumn(p.x + d);
+                clearRow(p.y + d);
+            }
+        }
+    } else if (t.type == ContentT::WrappedCandy) {
+        clearWithoutEffect(other);
+        t.set(Tile::Clearing);
+        if (o.type == ContentT::WrappedCandy) {
+            t.set(Tile::Armed);
+            t.set(Tile::DoubleWrapped);
+            clearSquare(p, 2);
+        } else {
+            for (int d = -1; d <= 1; ++d) {
+                clearColumn(p.x + d);
+                clearRow(p.y + d);
+            }
+        }
+    }
+}
+
+/**
+ * Swaps the content of two neighbouring cells and processes
+ * the outcome of the swap, see SwapState. The content moved
+ * to b is the one of the last selected cell.
+ *
+ * @return whether the swap was kept, if nothing is matched
+ * the contents are swapped back
+ */
+bool BoardEngine::swap(const Point &a, const Point &b)
+{
+    Point diff {a-b};
+    if (std::abs(diff.x) + std::abs(diff.y) != 1
+            || !board.at(a).isMovable() || !board.at(b).isMovable())
+        return false;
+
+    std::swap(board.at(a), board.at(b));
+
+    swapEffect(b, a);
+    swapEffect(a, b);
+
+    m_bitsStale = true;
+    if (!isWaiting()) {
+        bool aFirst {a.y < b.y || (a.y == b.y && a.x < b.x)};
+        processCombinationContaining(aFirst ? a : b);
+        processCombinationContaining(aFirst ? b : a);
+    }
+
+    if (!isWaiting()) {
+        std::swap(board.at(a), board.at(b));
+        return false;
+    }
+    m_changed.mark(a);
+    m_changed.mark(b);
+    return true;
+}
+
+/**
+ * Clears, falls and processes new combinations until
+ * the board is stable.
+ */
+void BoardEngine::settle()
+{
+    while (isWaiting()) {
+        ++m_cascades;
+        removeCleared();
+        fillGrid();
+        endRound();
+        fallEnd();
+    }
+}
+
+/**
+ * Plays a whole turn
+ *
+ * @return whether the move was valid
+ */
+bool BoardEngine::playMove(const Point &a, const Point &b)
+{
+    m_cascades = 0;
+    if (!swap(a, b))
+        return false;
+    settle();
+    notifyObservers(Event::TurnEnd);
+    return true;
+}
+
+/**
+ * The logged round is over, what comes next goes in a new one
+ */
+void BoardEngine::endRound()
+{
+    if (!m_log)
+        return;
+    m_log->rounds.back().score = m_score - m_roundStart;
+    m_roundStart = m_score;
+    m_log->rounds.emplace_back();
+}
+
+/**
+ * Plays a whole turn like playMove, and tells what happened
+ *
+ * @return the rounds of the turn, none if the move was not valid
+ */
+TurnLog BoardEngine::resolveTurn(const Point &a, const Point &b)
+{
+    TurnLog log;
+    log.a = a;
+    log.b = b;
+    log.rounds.emplace_back();
+
+    int start {m_score};
+    m_roundStart = m_score;
+    m_log = &log;
+    log.valid = playMove(a, b);
+    m_log = nullptr;
+
+    // The round begun by the last fall found nothing to clear
+    log.rounds.pop_back();
+    log.score = m_score - start;
+    return log;
+}
@@ -0,0 +1,124 @@
+#ifndef BOARD_ENGINE_HPP
+#define BOARD_ENGINE_HPP
+
+#include <cstdint>
+
+#include "bitboard.hpp"
+#include "board.hpp"
+#include "board_geometry.hpp"
+#include "combination.hpp"
+#include "dirty_set.hpp"
+#include "event.hpp"
+#include "observer.hpp"
+#include "random.hpp"
+#include "turn_log.hpp"
+
+/**
+ * Plays the rules of the game on a Board, without any drawing
+ *
+ * This mirrors what the states do on the Grid (SwapState,
+ * MatchState, ClearState, FallState) and what the special
+ * candies do when cleared, but everything happens at once
+ * instead of being driven by the end of animations.
+ *
+ * The engine is the reference for the rules: every turn of the
+ * Grid is played again on an engine, which must end it the same
+ * way, see TurnCheck.
+ *
+ * Observers receive the same events the level receives
+ * while playing on the Grid (CellCleared, IcingCleared, TurnEnd)
+ * so goals can be plugged on it.
+ *
+ * Each engine draws its random numbers (new candies, axis of the
+ * striped candies...) from its own generator, so engines can play
+ * on different boards from different threads.
+ *
+ * @param board the board the engine plays on
+ * @param seed seed of the random generator of the engine
+ */
+class BoardEngine : public Subject
+{
+    private:
+        Board &board;
+        const BoardGeometry &m_geometry;
+        int m_score {0};
+        int m_cascades {0};  // clear and fall rounds of the last turn
+        Random m_random;
+        DirtySet m_changed;  // tiles filled since the last fall ended
+
+        MatchFinder m_finder {MatchFinder::Walker};
+        BitBoard m_bits;
+        bool m_bitsStale {true};  // the board changed since m_bits was read
+
+        TurnLog *m_log {nullptr};  // set while resolveTurn runs
+        int m_roundStart {0};      // score when the logged round began
+
+        TurnLog::Round *logged() { return m_log ? &m_log->rounds.back() : nullptr; }
+        void endRound();
+
+        Combination combinationContaining(const Point &p);
+
+        // Special candies effects
+        void explode(const Point &p);
+        void clearRow(int y);
+        void clearColumn(int x);
+        void clearSquare(const Point &center, int radius);
+        void replaceAndExplode(CandyColor color, ContentT replaceWith);
+        void swapEffect(const Point &p, const Point &other);
+
+        void removeLayer(const Point &p);
+        void notifyNeighboursMatched(const Combination &combi);
+        void put(const Point &p, ContentT type, CandyColor color, Axis axis);
+    public:
+        BoardEngine(Board &board, std::uint64_t seed = 1)
+            : board{board},
+              m_geometry{BoardGeometry::of(board.rowCount(), board.colCount())},
+              m_random{seed},
+              m_changed{board.rowCount(), board.colCount()},
+              m_bits{board.rowCount(), board.colCount()}
+        { }
+
+        /// Draws the same numbers as random would from now on
+        BoardEngine(Board &board, const Random &random)
+            : board{board},
+              m_geometry{BoardGeometry::of(board.rowCount(), board.colCount())},
+              m_random{random},
+              m_changed{board.rowCount(), board.colCount()},
+              m_bits{board.rowCount(), board.colCount()}
+        { }
+
+        // Tied to its board
+        BoardEngine(const BoardEngine &) = delete;
+        BoardEngine &operator=(const BoardEngine &) = delete;
+
+        Board &getBoard() { return board; }
+        int score() const { return m_score; }
+        int cascades() const { return m_cascades; }
+
+        void setMatchFinder(MatchFinder f) { m_finder = f; m_bitsStale = true; }
+        MatchFinder getMatchFinder() const { return m_finder; }
+
+        // Clearing, see Cell::clear and Cell::clearWithoutAnimation
+        bool clearCell(const Point &p);
+        void clearCellWithoutAnimation(const Point &p);
+        void clearWithoutEffect(const Point &p);
+
+        bool processCombinationContaining(const Point &p);
+        bool isWaiting() const;
+        void removeCleared();
+
+        // Start of the level, see GridInitState
+        void fillEmptyCells();
+
+        // Falling, see FallState
+        bool fillGrid();
+        void fallEnd();
+
+        bool swap(const Point &a, const Point &b);
+        static bool isSpecialSwap(const Tile &a, const Tile &b);
+        void settle();
+        bool playMove(const Point &a, const Point &b);
+        TurnLog resolveTurn(const Point &a, const Point &b);
+};
+
+#endif // BOARD_ENGINE_HPP
@@ -0,0 +1,86 @@
+#include "board_geometry.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <mutex>
+
+#include "board.hpp"
+
+/*----------------------------------------------------------
+ * BoardGeometry
+ *--------------------------------------------------------*/
+
+BoardGeometry::BoardGeometry(int rows, int columns)
+    : rows{rows}, columns{columns}
+{
+    const auto cells {static_cast<std::size_t>(rows*columns)};
+
+    m_neighbours.starts.reserve(cells+1);
+    for (int y = 0; y<rows; ++y)
+        for (int x = 0; x<columns; ++x) {
+            m_neighbours.starts.push_back(m_neighbours.points.size());
+            for (int d = 0; d<4; ++d) {
+                Point n {Point{x, y} + directionModifier[static_cast<unsigned>(d)]};
+                if (isIndexValid(n))
+                    m_neighbours.points.push_back(n);
+            }
+        }
+    m_neighbours.starts.push_back(m_neighbours.points.size());
+
+    for (int radius = 1; radius<=maxRadius; ++radius) {
+        Lists &square {m_squares[static_cast<std::size_t>(radius-1)]};
+        square.starts.reserve(cells+1);
+        for (int y = 0; y<rows; ++y)
+            for (int x = 0; x<columns; ++x) {
+                square.starts.push_back(square.points.size());
+                for (int dx = -radius; dx <= radius; ++dx)
+                    for (int dy = -radius; dy <= radius; ++dy)
+                        if (isIndexValid({x+dx, y+dy}))
+                            square.points.push_back({x+dx, y+dy});
+            }
+        square.starts.push_back(square.points.size());
+    }
+
+    m_rows.reserve(cells);
+    for (int y = 0; y<rows; ++y)
+        for (int x = 0; x<columns; ++x)
+            m_rows.push_back({x, y});
+
+    m_columns.reserve(cells);
+    for (int x = 0; x<columns; ++x)
+        for (int y = 0; y<rows; ++y)
+            m_columns.push_back({x, y});
+}
+
+namespace {
+
+constexpr std::size_t sizes {Board::maxSide+1};
+
+std::mutex madeMutex;
+std::array<std::unique_ptr<BoardGeometry>, sizes*sizes> made;
+
+// Geometries already made, read without locking
+std::array<std::atomic<const BoardGeometry *>, sizes*sizes> published;
+
+}  // namespace
+
+/**
+ * Engines are made from several threads at once (see MoveRanker),
+ * only the first use of a size takes the lock
+ */
+const BoardGeometry &BoardGeometry::of(int rows, int columns)
+{
+    assert(rows>0 && rows<=Board::maxSide && columns>0 && columns<=Board::maxSide);
+    const auto i {static_cast<std::size_t>(rows)*sizes + static_cast<std::size_t>(columns)};
+
+    if (const BoardGeometry *g {published[i].load(std::memory_order_acquire)})
+        return *g;
+
+    std::lock_guard lock {madeMutex};
+    if (!made[i]) {
+        made[i] = std::make_unique<BoardGeometry>(rows, columns);
+        published[i].store(made[i].get(), std::memory_order_release);
+    }
+    return *made[i];
+}
@@ -0,0 +1,96 @@
+#ifndef BOARD_GEOMETRY_HPP
+#define BOARD_GEOMETRY_HPP
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "point.hpp"
+
+/**
+ * Cells around each cell of a board of a given size, listed once
+ *
+ * Neighbours, rows, columns and the squares cleared by wrapped
+ * candies are kept as lists of points, so walking over them needs
+ * no bounds check and no allocation: cells out of the board are
+ * never part of a list, and lines out of the board are empty.
+ *
+ * A geometry never changes once made and is shared by all the
+ * boards of its size, see BoardGeometry::of.
+ *
+ * @param rows number of rows of the board
+ * @param columns number of columns of the board
+ */
+class BoardGeometry
+{
+    public:
+        using Span = std::span<const Point>;
+
+        static constexpr int maxRadius {2};  // 5x5 squares, see WrappedCandy
+    private:
+        /// A list per cell, the one of cell i from starts[i] to starts[i+1]
+        struct Lists
+        {
+            std::vector<Point> points {};
+            std::vector<std::size_t> starts {};
+
+            Span of(std::size_t i) const
+            {
+                return Span{points}.subspan(starts[i], starts[i+1] - starts[i]);
+            }
+        };
+
+        int rows;
+        int columns;
+
+        Lists m_neighbours {};
+        std::array<Lists, maxRadius> m_squares {};  // by radius, from 1
+        std::vector<Point> m_rows {};     // row by row
+        std::vector<Point> m_columns {};  // column by column
+
+        std::size_t indexOf(const Point &p) const
+        {
+            return static_cast<std::size_t>(p.y*columns + p.x);
+        }
+    public:
+        BoardGeometry(int rows, int columns);
+
+        /// The geometry of the boards of that size, made on first use
+        static const BoardGeometry &of(int rows, int columns);
+
+        bool isIndexValid(const Point &p) const
+        {
+            return p.x>=0 && p.x<columns && p.y>=0 && p.y<rows;
+        }
+
+        /// Cells next to p, in the order of Direction (south, north, west, east)
+        Span neighboursOf(const Point &p) const { return m_neighbours.of(indexOf(p)); }
+
+        /// Cells of row y from west to east, none if y is out of the board
+        Span row(int y) const
+        {
+            if (y<0 || y>=rows)
+                return {};
+            return Span{m_rows}.subspan(static_cast<std::size_t>(y*columns), static_cast<std::size_t>(columns));
+        }
+
+        /// Cells of column x from south to north, none if x is out of the board
+        Span column(int x) const
+        {
+            if (x<0 || x>=columns)
+                return {};
+            return Span{m_columns}.subspan(static_cast<std::size_t>(x*rows), static_cast<std::size_t>(rows));
+        }
+
+        /**
+         * Cells at most radius (1 or 2) away from center on both
+         * axes, center included, column by column from the west
+         */
+        Span square(const Point &center, int radius) const
+        {
+            return m_squares[static_cast<std::size_t>(radius-1)].of(indexOf(center));
+        }
+};
+
+#endif // BOARD_GEOMETRY_HPP
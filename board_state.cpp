@@ -1,103 +1,8 @@
 #include "board_state.hpp"
+#include "candy_generator.hpp"
 #include "game.hpp"
-
-/*----------------------------------------------------------
- * Combination
- *--------------------------------------------------------*/
-
-Combination::Combination(const Point &point)
-    : origin{point}
-{ }
-
-auto Combination::getOrigin() const
-{
-    return origin;
-}
-
-void Combination::setOrigin(const Point &orig)
-{
-    origin = orig;
-}
-
-bool Combination::isEmpty() const
-{
-    return horizontal.empty() && vertical.empty();
-}
-
-void Combination::addVerticalElement(const Point &elem)
-{
-    assert(elem.x == origin.x);
-    vertical.push_back(elem);
-}
-
-void Combination::addHorizontalElement(const Point &elem)
-{
-    assert(elem.y == origin.y);
-    horizontal.push_back(elem);
-}
-
-void Combination::addElement(const Point &elem, Direction direction)
-{
-    switch (direction) {
-        case Direction::South:
-        case Direction::North:
-            addVerticalElement(elem);
-            break;
-        case Direction::West:
-        case Direction::East:
-            addHorizontalElement(elem);
-            break;
-        default:
-            std::runtime_error("Combination: given direction is unsupported");
-    }
-}
-
-std::size_t Combination::getVerticalCount() const
-{
-    return vertical.size()+1;
-}
-
-std::size_t Combination::getHorizontalCount() const
-{
-    return horizontal.size()+1;
-}
-
-std::size_t Combination::getTotalCount() const
-{
-    std::size_t ret{ 0 };
-    ret += getHorizontalCount()>2 ? getHorizontalCount() : 0;
-    ret += getVerticalCount()>2 ? getVerticalCount() : 0;
-    return ret;
-}
-
-auto Combination::getVerticalElements()
-{
-    return vertical;
-}
-
-auto Combination::getHorizontalElements()
-{
-    return horizontal;
-}
-
-auto Combination::getAllElements()
-{
-    std::vector<Point> ret;
-    ret.reserve(vertical.size() + horizontal.size());
-    ret.insert(ret.end(), vertical.begin(), vertical.end());
-    ret.insert(ret.end(), horizontal.begin(), horizontal.end());
-    return ret;
-}
-
-void Combination::removeVerticalElems()
-{
-      vertical.clear();
-}
-
-void Combination::removeHorizontalElems()
-{
-    horizontal.clear();
-}
+#include "gravity.hpp"
+#include "move_finder.hpp"
 
 /*----------------------------------------------------------
  * State
@@ -131,47 +36,32 @@ void State::update(Event event)
  * MessageState
  *--------------------------------------------------------*/
 
-MessageState::MessageState(Level &level, Grid &grid, std::string msg, int duration) noexcept
+MessageState::MessageState(Level &level, Grid &grid, std::string msg, std::chrono::milliseconds duration) noexcept
     :
         State{level, grid},
         DrawableContainer{std::make_shared<Rectangle>(grid.getCenter(), level.w(), 50, FL_WHITE)},
-        message{grid.getCenter(), msg, 14}
-{
-    addAnimation(std::make_shared<StillAnimation>(duration));
-}
+        message{grid.getCenter(), msg, 14},
+        m_until{FrameClock::now() + duration}
+{ }
 
 void MessageState::draw()
 {
     DrawableContainer::draw();
     message.draw();
 
-    // This is dirty, but a way to know when the animation is
-    // done and any action can be done. Sometimes changing state
-    // in animationFinished could make the program call pure
-    // virtual functions, something that doesn't happen here.
-    // TODO put it in postDraw()
-    if (messageFinished)
+    // Changing state is done last, once nothing
+    // of this one is used anymore
+    if (FrameClock::now() >= m_until)
         onTimeout();
 }
 
-void MessageState::animationFinished(AnimationT animationType)
-{
-    switch (animationType) {
-        case AnimationT::StillAnimation:
-            messageFinished = true;
-            break;
-        default:
-            break;
-    }
-}
-
 /*----------------------------------------------------------
  * NoActionState
  *--------------------------------------------------------*/
 
 NoActionState::NoActionState(Level &level, Grid &grid) noexcept
     :
-        MessageState{level, grid, "No more combinations. Changing grid.", 60}
+        MessageState{level, grid, "No more combinations. Changing grid.", std::chrono::seconds{1}}
 { }
 
 void NoActionState::onTimeout()
@@ -185,7 +75,7 @@ void NoActionState::onTimeout()
 
 LevelPassedState::LevelPassedState(Level &level, Grid &grid) noexcept
     :
-        MessageState{level, grid, "You won! Loading next level...", 120}
+        MessageState{level, grid, "You won! Loading next level...", std::chrono::seconds{2}}
 { }
 
 void LevelPassedState::onTimeout()
@@ -199,7 +89,7 @@ void LevelPassedState::onTimeout()
 
 LevelNotPassedState::LevelNotPassedState(Level &level, Grid &grid) noexcept
     :
-        MessageState{level, grid, "Thou lost... Try again!", 120}
+        MessageState{level, grid, "Thou lost... Try again!", std::chrono::seconds{2}}
 { }
 
 void LevelNotPassedState::onTimeout()
@@ -215,29 +105,26 @@ void EditState::selectionChanged()
 {
     assert(grid.getSelectedCount() == 1);
 
-    auto selection = grid.getSelected();
+    Point selected {grid.getSelected().at(0)};
     grid.clearSelection();
 
     /* grid.put(selection.at(0), ContentT::StandardCandy, StandardCandy::Color::Red); */
-    grid.put(selection.at(0), ContentT::Wall);
+    grid.put(selected, ContentT::Wall);
 }
 
 void EditState::mouseMove(Point mouseLoc)
 {
-    for (auto &c: grid)
-        c.mouseMove(mouseLoc);
+    grid.mouseMove(mouseLoc);
 }
 
 void EditState::mouseClick(Point mouseLoc)
 {
-    for (auto &c: grid)
-        c.mouseClick(mouseLoc);
+    grid.mouseClick(mouseLoc);
 }
 
 void EditState::mouseDrag(Point mouseLoc)
 {
-    for (auto &c: grid)
-        c.mouseDrag(mouseLoc);
+    grid.mouseDrag(mouseLoc);
 }
 
 /*----------------------------------------------------------
@@ -250,52 +137,51 @@ bool MatchState::processCombinationContaining(const Point &elem)
         return false;
 
     auto combi {getCombinationContaining(elem)};
-    bool oneCombination {false};
+    bool oneCombination {true};
 
     Point origin {combi.getOrigin()};
     std::size_t vc = combi.getVerticalCount();
     std::size_t hc = combi.getHorizontalCount();
 
     auto largestDirection {hc>vc ? combi.getHorizontalElements() : combi.getVerticalElements()};
-    auto smallestDirection {hc<vc ? combi.getHorizontalElements() : combi.getVerticalElements()};
-
-    // 3 in one axis
-    if ((vc==3 && hc<3) || (hc==3 && vc<3)) {
-        grid.clearCell(origin);
-        grid.clearCell(largestDirection);
-        oneCombination = true;
-        level.updateScore(50);
-
-    // 4 in one axis
-    } else if ((vc==4 && hc<3) || (hc==4 && vc<3)) {
-        StandardCandy::Color color {std::dynamic_pointer_cast<StandardCandy>(grid.at(origin).getContent())->getColor()};  // TODO simplify this
-
-        grid.clearCellWithoutAnimation(origin);
-        grid.clearCell(largestDirection);
-        grid.put(origin, ContentT::StripedCandy, color, vc<hc ? Axis::Vertical : Axis::Horizontal);
-        oneCombination = true;
-        level.updateScore(125);
-
-    // More than 3 on both axis
-    } else if (vc>=3 && vc<5 && hc>=3 && hc<5) {
-        StandardCandy::Color color {std::dynamic_pointer_cast<StandardCandy>(grid.at(origin).getContent())->getColor()};
-        grid.clearCellWithoutAnimation(origin);
-        for (auto &a: combi.getAllElements()) {
-            grid.clearCell(a);
+
+    switch (combi.type()) {
+        case CombinationT::Line3: {
+            grid.clearCell(origin);
+            grid.clearCell(largestDirection);
+            level.updateScore(50);
+            break;
         }
-        grid.put(origin, ContentT::WrappedCandy, color);
-        oneCombination = true;
-        level.updateScore(200);
-
-    // 5 or more in one axis
-    } else if (vc>=5 || hc>=5) {
-        grid.clearCellWithoutAnimation(origin);
-        grid.clearCell(largestDirection);
-        grid.put(origin, ContentT::ColourBomb);
-        oneCombination = true;
-        level.updateScore(500);
-    }
+        case CombinationT::Line4: {
+            StandardCandy::Color color {grid.at(origin).getContent()->tile().color};
 
+            grid.clearCellWithoutAnimation(origin);
+            grid.clearCell(largestDirection);
+            grid.put(origin, ContentT::StripedCandy, color, vc<hc ? Axis::Vertical : Axis::Horizontal);
+            level.updateScore(125);
+            break;
+        }
+        case CombinationT::Cross: {
+            StandardCandy::Color color {grid.at(origin).getContent()->tile().color};
+            grid.clearCellWithoutAnimation(origin);
+            for (auto &a: combi.getAllElements()) {
+                grid.clearCell(a);
+            }
+            grid.put(origin, ContentT::WrappedCandy, color, Axis::Vertical);
+            level.updateScore(200);
+            break;
+        }
+        case CombinationT::Line5: {
+            grid.clearCellWithoutAnimation(origin);
+            grid.clearCell(largestDirection);
+            grid.put(origin, ContentT::ColourBomb);
+            level.updateScore(500);
+            break;
+        }
+        default:
+            oneCombination = false;
+            break;
+    }
 
     if (oneCombination) {
         auto vec{ combi.getAllElements() };
@@ -330,22 +216,25 @@ bool MatchState::processCombinationContaining(const Point &elem)
 Combination MatchState::getCombinationContaining(const Point &origin, bool rec)
 {
     assert(!grid.at(origin).isContentClearing());
+    if (grid.getMatchFinder() == MatchFinder::Bitboard)
+        return grid.bitboard().getCombinationContaining(origin, rec);
+
     Combination ret{origin};
 
     // Gather combination having origin as starting point
     for (auto &direction: {Direction::East, Direction::North, Direction::West, Direction::South}) {
         Point curr{origin};
         /* Point next{origin, direction}; TODO */
-        Point next{origin + Grid::directionModifier[static_cast<unsigned>(direction)]};
+        Point next{origin + directionModifier[static_cast<unsigned>(direction)]};
 
-        while (grid.isIndexValid(next)
-                && !grid.isCellEmpty(next)
+        // The border of the grid is empty, stopping the walk
+        while (!grid.isCellEmpty(next)
                 && grid.hasCellMatchWith(curr, next)
                 && !grid.at(next).isContentClearing())
         {
             curr = next;
             ret.addElement(curr, direction);
-            next = Point{curr + Grid::directionModifier[static_cast<unsigned>(direction)]};
+            next = Point{curr + directionModifier[static_cast<unsigned>(direction)]};
         }
     }
 
@@ -370,6 +259,9 @@ Combination MatchState::getCombinationContaining(const Point &origin, bool rec)
  */
 bool MatchState::isInCombination(const Point &point)
 {
+    if (grid.getMatchFinder() == MatchFinder::Bitboard)
+        return grid.bitboard().isInCombination(point);
+
     auto combi = getCombinationContaining(point);
     return combi.getVerticalCount() >= 3
         || combi.getHorizontalCount() >= 3;
@@ -477,17 +369,15 @@ void GridInitState::putInitialContent(LevelData &data)
     grid.put(point, ContentT::Icing, StandardCandy::Color::Blue);*/
 }
 
+/**
+ * Candies are drawn on a snapshot, in a single pass,
+ * then put on the grid
+ */
 void GridInitState::fillEmptyCells()
 {
-    for (auto &c: grid) {
-        if (c.isEmpty()) {
-            grid.put(c.getIndex(), ContentT::StandardCandy);
-            while (isInCombination(c.getIndex())) {
-                c.removeContent();
-                grid.put(c.getIndex(), ContentT::StandardCandy);
-            }
-        }
-    }
+    Board filled {grid.snapshot()};
+    CandyGenerator{filled, grid.random()}.fillEmpty();
+    grid.restore(filled);
 }
 
 /*----------------------------------------------------------
@@ -498,9 +388,9 @@ ReadyState::ReadyState(Level &level, Grid &grid, bool replaceGrid_) noexcept
     : MatchState{level, grid}
 {
     std::cout << "Entering Ready state" << std::endl;
-    if (replaceGrid_)
-        while (!isActionPossible())
-            replaceGrid();
+    if (replaceGrid_ && !isActionPossible())
+        replaceGrid();
+    grid.clearChangedCells();  // the grid is stable, nothing left to look at
     hasPossibleAction = isActionPossible();
     bestCombination = getBestCombination();
     /* std::cout << (hasPossibleAction ? "More action" : "No more action") << std::endl; */
@@ -508,26 +398,33 @@ ReadyState::ReadyState(Level &level, Grid &grid, bool replaceGrid_) noexcept
 
 void ReadyState::draw()
 {
-    if (grid.getSelectedCount() == 0) {
-        --countToNextHint;
-        if (countToNextHint == 0)
-            showHint();
+    if (grid.getSelectedCount() == 0 && FrameClock::now() >= hintAt) {
+        hintAt = noHint;  // until the hint is over
+        showHint();
     }
     if (!hasPossibleAction)
         level.setState(std::make_shared<NoActionState>(level, grid));
 }
 
+/**
+ * The hint is shown at hintAt, unless a cell is selected
+ */
+std::optional<FrameClock::TimePoint> ReadyState::nextDeadline() const
+{
+    if (grid.getSelectedCount() == 0 && hintAt != noHint)
+        return hintAt;
+    return std::nullopt;
+}
+
 void ReadyState::replaceGrid()
 {
-    for (auto &c: grid) {
-        if (!c.isEmpty() && c.contentType() == ContentT::StandardCandy) {
-            grid.put(c.getIndex(), ContentT::StandardCandy);
-            while (isInCombination(c.getIndex())) {
-                c.removeContent();
-                grid.put(c.getIndex(), ContentT::StandardCandy);
-            }
-        }
-    }
+    // Candies are shuffled on a snapshot, only the
+    // ones that changed are then put on the grid
+    Board shuffled {grid.snapshot()};
+    CandyGenerator generator {shuffled, grid.random()};
+    if (!generator.shuffle())
+        generator.recolor();  // too few candies of a colour to plant a move
+    grid.restore(shuffled);
 }
 
 Combination ReadyState::getBestSpecialCombination()
@@ -581,22 +478,12 @@ Combination ReadyState::getBestCombination()
     if (!ret.isEmpty())
         return ret;
 
-    for (auto &c: grid) {
-        for (auto &d: {Direction::North, Direction::East}) {
-            if (grid.isIndexValid(c.getIndex(), d)) {
-                std::vector<Point> toSwap {c.getIndex(), grid.at(c.getIndex(), d).getIndex()};
-                grid.swapCellContentWithoutAnimation(toSwap);
-
-                for (unsigned i = 0; i<2; ++i) {
-                    Combination tmp = getCombinationContaining(toSwap[i]);
-                    if (tmp.getTotalCount() > ret.getTotalCount()) {
-                        ret = std::move(tmp);
-                        ret.setOrigin(toSwap.at((i+1)%2));
-                    }
-                }
-                grid.swapCellContentWithoutAnimation(toSwap);
-            }
-        }
+    // The swaps are evaluated on the bitboard, without being played
+    MoveFinder finder {grid.bitboard()};
+    Swap best {finder.best()};
+    if (best.isValid()) {
+        ret = finder.combinationOf(best);
+        ret.setOrigin(best.from);  // the candy to move
     }
 
     if (ret.getVerticalCount() < 3)
@@ -609,7 +496,8 @@ Combination ReadyState::getBestCombination()
 
 bool ReadyState::isActionPossible()
 {
-    return !getBestCombination().isEmpty();
+    return !getBestSpecialCombination().isEmpty()
+        || MoveFinder{grid.bitboard()}.hasMove();
 }
 
 void ReadyState::gridAnimationFinished(const Point &)
@@ -618,7 +506,7 @@ void ReadyState::gridAnimationFinished(const Point &)
     /* waitingList.push_back(p); */
 
     if (!isWaiting()) {
-        countToNextHint = hintInterval;
+        hintAt = FrameClock::now() + hintInterval;
     }
 }
 
@@ -635,7 +523,7 @@ void ReadyState::mouseClick(Point mouseLoc)
 
 void ReadyState::suspendHint()
 {
-    countToNextHint = hintInterval;
+    hintAt = FrameClock::now() + hintInterval;
     grid.removeAnimations();
 }
 
@@ -648,16 +536,21 @@ void ReadyState::selectionChanged()
 {
     if (grid.getSelectedCount() == 2) {
 
-        auto selection = grid.getSelected();
+        Selection selection {grid.getSelected()};  // a copy, kept once cleared
         grid.clearSelection();
 
         if (
                 !grid.at(selection.at(0)).isEmpty()
                 && !grid.at(selection.at(1)).isEmpty()
                 && grid.areNeighbours(selection.at(0), selection.at(1))
-                && grid.swapCellContent(selection)
            ) {
-            level.setState(std::make_shared<SwapState>(level, grid));
+            // The cell selected last goes second, see BoardEngine::swap
+            const bool firstIsLast {grid.at(selection.at(0)).isLastSelected()};
+            level.turnCheck().begin(grid.model(), grid.random(),
+                    selection.at(firstIsLast ? 1 : 0), selection.at(firstIsLast ? 0 : 1), level.score());
+
+            if (grid.swapCellContent(selection.at(0), selection.at(1)))
+                level.setState(std::make_shared<SwapState>(level, grid));
         }
     }
 }
@@ -675,99 +568,33 @@ void ReadyState::showHint()
  *--------------------------------------------------------*/
 
 /**
- * Fills the empty cells of the grid with new content
- * falling from above.
+ * Makes every content fall to where it will stay,
+ * with a single animation each, see Gravity
+ *
+ * @return whether anything fell
  */
 bool FallState::fillGrid()
 {
-    bool hasFallen{false};
-    for (auto &a: grid) {
-        bool curr = makeFall(a.getIndex());
-        hasFallen = hasFallen || curr;
-    }
-    return hasFallen;
-}
-
-//ok, get comment
-bool FallState::makeFall(const Point &p)
-{
-    bool hasFallen = false;
-
-    if (!grid.at(p).isEmpty() && grid.at(p).isContentMovable()) {
-        for (auto &d: {Direction::South, Direction::SouthWest, Direction::SouthEast}) {
-            if (canFallTo(p, d)) {
-                if (grid.at(p).moveContentTo(grid.at(p, d))) {
-                    hasFallen = true;
-                }
-                break;
-            }
+    Board settled {grid.model()};
+    auto falls {Gravity{settled, grid.random()}.settle()};
+
+    // Every content leaves its cell before any lands,
+    // one may end where another one started
+    std::vector<std::shared_ptr<CellContent>> falling;
+    falling.reserve(falls.size());
+    for (auto &f: falls) {
+        if (f.isNew) {
+            Cell &top {grid.at(f.path.front())};
+            falling.push_back(grid.pool().make<StandardCandy>(grid, &top, top.getCenter() - Point{0, grid.getRowSize()}, grid.getCellContentSide(), f.tile.color));
+        } else {
+            falling.push_back(grid.at(f.from).takeContent());
         }
     }
 
-    // TODO rework this part
-    if (grid.at(p).isEmpty() && p.y == static_cast<int>(grid.rowCount()-1)) {
-        Cell buffer{grid.at(p).getCenter() - Point{0, grid.getRowSize()}, 0, 0, {-1, -1}, grid};
-        buffer.setContent(std::make_shared<StandardCandy>(grid, &buffer, buffer.getCenter(), grid.getCellContentSide(), static_cast<StandardCandy::Color>(std::rand()%grid.getCandyColorRange())));
-        buffer.moveContentTo(grid.at(p));
-        hasFallen = true;
-    }
-    return hasFallen;
-}
-
-/**
- * Whether a given content can fall to the given direction
- * from his current position.
- */
-bool FallState::canFallTo(const Point &p, Direction target)
-{
-    bool canFall{false};
-
-    if (target == Direction::South) {
-        canFall = grid.isIndexValid(p, Direction::South)
-            && grid.at(p, Direction::South).isEmpty();
-
-    } else if (target==Direction::SouthWest || target==Direction::SouthEast) {
-        Direction helper{ target==Direction::SouthWest ? Direction::West : Direction::East};
-        canFall =
-            grid.isIndexValid(p, target)
-            && grid.at(p, target).isEmpty()
-            && (
-                    (grid.isIndexValid(p, helper)
-                    && !grid.at(p, helper).isEmpty()
-                    && !grid.at(p, helper).isContentMovable())
-                    || (
-                        !isFillableByFall(grid.at(p, target).getIndex())
-                        && !isFillableByFall(p)
-                       )
-               );
-    }
-
-    return canFall;
-}
-
-/**
- * Return whether a cell can be filled by vertical fall
- *
- * Conditions:
- *  - a cell above is not movable;
- *  - cells between the current and the one note movable are empty
- *      and not buffers
- */
-bool FallState::isFillableByFall(const Point &point)
-{
-    bool fillable{true};
-    bool empty{true};
-    Point current{point};
+    for (std::size_t i = 0; i<falls.size(); ++i)
+        grid.at(falls[i].path.back()).receiveContent(std::move(falling[i]), falls[i].path);
 
-    while (empty && grid.isIndexValid(current, Direction::North)) {
-        current = grid.at(current, Direction::North).getIndex();
-        empty = grid.at(current).isEmpty();
-        if (!empty) {
-            fillable = grid.at(current).isContentMovable();
-        }
-    }
-
-    return fillable;
+    return !falls.empty();
 }
 
 void FallState::gridAnimationFinished(const Point &p)
@@ -783,14 +610,16 @@ void FallState::gridAnimationFinished(const Point &p)
             // TODO
             notifyCells(Event::FallStateEnd);
 
-            for (auto &i: grid) {
-                processCombinationContaining(i.getIndex());
-            }
+            // Only cells that changed can be part of a new combination,
+            // see BoardEngine::fallEnd
+            for (auto &p: grid.takeChangedCells())
+                while (processCombinationContaining(p)) { }
 
 
             if (isWaiting())
                 level.setState(std::make_shared<ClearState>(level, grid));
             else {
+                assert(level.turnCheck().matches(grid.model(), level.score()));
                 level.setState(std::make_shared<ReadyState>(level, grid));
                 level.update(Event::TurnEnd);
             }
@@ -828,9 +657,10 @@ void SwapState::gridAnimationFinished(const Point &p)
         if (isWaiting()) {
             level.setState(std::make_shared<ClearState>(level, grid));
         } else if (!swapBack) {
-            grid.swapCellContent(waitingList);
+            grid.swapCellContent(waitingList.at(0), waitingList.at(1));
             swapBack = true;
         } else {
+            assert(level.turnCheck().matches(grid.model(), level.score()));
             level.setState(std::make_shared<ReadyState>(level, grid));
         }
     }
@@ -1,8 +1,12 @@
 #ifndef BOARD_STATE_HPP
 #define BOARD_STATE_HPP
 
+#include <optional>
+
 #include "common.hpp"
+#include "combination.hpp"
 #include "event.hpp"
+#include "frame_clock.hpp"
 #include "grid.hpp"
 
 class Grid;
@@ -73,38 +77,6 @@ class Level;
 
 /* color.getName(); */
 
-class Combination
-{
-    private:
-        Point origin;
-        std::vector<Point> vertical {};
-        std::vector<Point> horizontal {};
-    public:
-        Combination(const Point &point);
-
-        auto getOrigin() const;
-        void setOrigin(const Point &orig);
-
-        bool isEmpty() const;
-
-        void addVerticalElement(const Point &elem);
-        void addHorizontalElement(const Point &elem);
-        void addElement(const Point &elem, Direction direction);
-
-        // These include the origin
-        std::size_t getVerticalCount() const;
-        std::size_t getHorizontalCount() const;
-        std::size_t getTotalCount() const;
-
-        // These don't include the origin
-        auto getVerticalElements();
-        auto getHorizontalElements();
-        auto getAllElements();
-
-        void removeVerticalElems();
-        void removeHorizontalElems();
-};
-
 /**
  * Base class to any state
  *
@@ -138,6 +110,16 @@ class State : public Interactive
 
         virtual void draw() { }
 
+        /**
+         * Whether the state has nothing to do on the next frames,
+         * until the user does something, an animation ends or
+         * its next deadline is reached
+         */
+        virtual bool isIdle() const { return true; }
+
+        /// When the state has something to do next, if it is waiting for a time
+        virtual std::optional<FrameClock::TimePoint> nextDeadline() const { return std::nullopt; }
+
         // No interactions by default
         void mouseMove(Point) override { }
         void mouseClick(Point) override { }
@@ -178,16 +160,16 @@ class MessageState : public State, DrawableContainer
 {
     protected:
         Text message;
-        bool messageFinished {false};
+        FrameClock::TimePoint m_until;  // when the message is done
 
         // Function to be executed when the duration elapses
         virtual void onTimeout() = 0;
     public:
-        MessageState(Level &level, Grid &grid, std::string msg, int duration = 60) noexcept;
+        MessageState(Level &level, Grid &grid, std::string msg, std::chrono::milliseconds duration = std::chrono::seconds{1}) noexcept;
 
         void draw() override;
+        std::optional<FrameClock::TimePoint> nextDeadline() const override { return m_until; }
         void gridAnimationFinished(const Point &) override { }
-        void animationFinished(AnimationT animationType) override;
 };
 
 class NoActionState : public MessageState
@@ -273,6 +255,7 @@ class GridInitState : public MatchState
         GridInitState(Level &level, Grid &grid, LevelData &data);
 
         void draw() override;
+        bool isIdle() const override { return false; }  // ready on the next frame
         void gridAnimationFinished(const Point &) override { }
 };
 
@@ -301,12 +284,15 @@ class ReadyState : public MatchState
 
         Combination bestCombination{Point{0, 0}};
 
-        static constexpr int hintInterval {120};
-        int countToNextHint{hintInterval};
+        static constexpr std::chrono::milliseconds hintInterval {2000};
+        static constexpr FrameClock::TimePoint noHint {FrameClock::TimePoint::max()};
+        FrameClock::TimePoint hintAt {FrameClock::now() + hintInterval};
     public:
         ReadyState(Level &level, Grid &grid, bool initG = false) noexcept;
 
         void draw() override;
+        bool isIdle() const override { return hasPossibleAction; }
+        std::optional<FrameClock::TimePoint> nextDeadline() const override;
 
         void mouseMove(Point mouseLoc) override;
         void mouseClick(Point mouseLoc) override;
@@ -331,7 +317,7 @@ class ReadyState : public MatchState
                     selectionChanged();
                     break;
                 /* case Event::HintAnimationFinished: */
-                /*     countToNextHint = hintInterval; */
+                /*     hintAt = FrameClock::now() + hintInterval; */
                 default:
                     break;
             }
@@ -361,9 +347,6 @@ class FallState : public MatchState
         }
 
         bool fillGrid();
-        bool makeFall(const Point &p);
-        bool canFallTo(const Point &p, Direction target);
-        bool isFillableByFall(const Point &point);
 
         void gridAnimationFinished(const Point &p) override;
 };
@@ -0,0 +1,233 @@
+#include "candy_generator.hpp"
+
+#include <bit>
+
+#include "bitboard.hpp"
+#include "move_finder.hpp"
+
+/*----------------------------------------------------------
+ * CandyGenerator
+ *--------------------------------------------------------*/
+
+namespace {
+
+/**
+ * Ways to plant a move around a tile: the run of three starts on
+ * the tile and goes east or north, one of its three places (the
+ * gap) is left to another colour, and the candy of the run's colour
+ * that completes it when swapped sits on either side of the gap
+ */
+constexpr int patterns {2*3*2};
+
+constexpr int maxDeals {16};  // shuffles tried before giving up
+
+}  // namespace
+
+/**
+ * @param isTarget whether a tile is to be coloured, must not
+ *        change for a tile that isn't coloured yet
+ */
+template<typename IsTarget>
+void CandyGenerator::generate(IsTarget isTarget)
+{
+    const int range {board.getColorRange()};
+    auto isPending = [&](const Point &q) { return isTarget(board.at(q)); };
+
+    for (int i = 0; i<board.size(); ++i) {
+        const Point p {board.pointOf(i)};
+        Tile &t {board.at(p)};
+        if (!isTarget(t))
+            continue;
+
+        const std::uint32_t out {ruledOut(p, isPending) & ((1u << range) - 1)};
+        const int allowed {range - std::popcount(out)};
+
+        int color {0};
+        if (allowed == 0) {
+            color = random.below(range);
+        } else {
+            // The n-th colour that isn't ruled out
+            int n {random.below(allowed)};
+            for (;; ++color)
+                if (!(out >> color & 1u) && n-- == 0)
+                    break;
+        }
+
+        if (t.isEmpty())
+            t = Tile{};
+        t.type = ContentT::StandardCandy;
+        t.color = static_cast<CandyColor>(color);
+    }
+}
+
+/**
+ * Colours with which the tile at p would make a run of three along
+ * either axis with the tiles settled on that axis, one bit each
+ *
+ * @param isPending whether a tile after p is still to be coloured
+ */
+template<typename IsPending>
+std::uint32_t CandyGenerator::ruledOut(const Point &p, IsPending isPending) const
+{
+    const int i {indexOf(p)};
+
+    // Candy on the settled tile at p+offset, if any
+    auto settled = [&](const Point &offset) -> const Tile * {
+        Point q {p+offset};
+        if (!board.isIndexValid(q))
+            return nullptr;
+        const Tile &t {board.at(q)};
+        return (indexOf(q) < i || !isPending(q)) && t.isMatchable() ? &t : nullptr;
+    };
+
+    std::uint32_t ret {0};
+    for (const Point d: {directionModifier[static_cast<unsigned>(Direction::East)],
+                         directionModifier[static_cast<unsigned>(Direction::North)]}) {
+        // The three runs of three p can be part of, p aside
+        const std::array<std::array<Point, 2>, 3> runs {{
+            {d*-2, d*-1},
+            {d*-1, d},
+            {d, d*2}
+        }};
+        for (auto &run: runs) {
+            const Tile *a {settled(run[0])};
+            const Tile *b {settled(run[1])};
+            if (a && b && a->matches(*b))
+                ret |= 1u << static_cast<unsigned>(a->color);
+        }
+    }
+    return ret;
+}
+
+void CandyGenerator::fillEmpty()
+{
+    generate([](const Tile &t) { return t.isEmpty(); });
+}
+
+void CandyGenerator::recolor()
+{
+    generate([](const Tile &t) { return t.type == ContentT::StandardCandy; });
+}
+
+/**
+ * Sites are looked at from a random one, each once at most, and
+ * candies are only dealt around the ones where a move fits
+ */
+bool CandyGenerator::shuffle()
+{
+    Counts counts {};
+    for (int i = 0; i<board.size(); ++i) {
+        const Tile &t {board.at(board.pointOf(i))};
+        if (t.type == ContentT::StandardCandy)
+            ++counts[static_cast<std::size_t>(t.color)];
+    }
+
+    // Colours with enough candies to plant a move
+    std::array<int, maxColors> plantable {};
+    int plantableCount {0};
+    for (int c = 0; c<maxColors; ++c)
+        if (counts[static_cast<std::size_t>(c)] >= 3)
+            plantable[static_cast<std::size_t>(plantableCount++)] = c;
+    if (plantableCount == 0)
+        return false;
+
+    const Board original {board};
+    const int sites {board.size()*patterns};
+    const int first {random.below(sites)};
+    for (int k = 0, deals = 0; k<sites && deals<maxDeals; ++k) {
+        auto plant {plantAt((first+k) % sites)};
+        if (!plant)
+            continue;
+        int color {plantable[static_cast<std::size_t>(random.below(plantableCount))]};
+        if (shuffleAround(*plant, color, counts))
+            return true;
+        board = original;
+        ++deals;
+    }
+    return false;
+}
+
+/**
+ * The candies of a move planted at the given site, if all of
+ * them (and the gap) are standard candies
+ */
+auto CandyGenerator::plantAt(int site) const -> std::optional<Plant>
+{
+    const Point p {board.pointOf(site / patterns)};
+    const int pattern {site % patterns};
+    const bool vertical {pattern >= patterns/2};
+    const Point along {directionModifier[static_cast<unsigned>(vertical ? Direction::North : Direction::East)]};
+    const Point across {directionModifier[static_cast<unsigned>(vertical ? Direction::East : Direction::North)]};
+    const int gap {pattern/2 % 3};
+    const int side {pattern%2 ? 1 : -1};
+
+    const Point gapPoint {p + along*gap};
+    const Plant ret {
+        p + along*((gap+1) % 3),
+        p + along*((gap+2) % 3),
+        gapPoint + across*side
+    };
+
+    auto isCandy = [&](const Point &q) {
+        return board.isIndexValid(q) && board.at(q).type == ContentT::StandardCandy;
+    };
+    if (!isCandy(gapPoint))
+        return std::nullopt;
+    for (auto &q: ret)
+        if (!isCandy(q))
+            return std::nullopt;
+    return ret;
+}
+
+/**
+ * Plants a move of the given colour, then deals the other candies
+ * in one pass, each colour being drawn as often as candies of it
+ * are left
+ *
+ * @return whether the board has no combination and a move
+ */
+bool CandyGenerator::shuffleAround(const Plant &plant, int color, Counts counts)
+{
+    // Candies still to be dealt, by index
+    std::array<bool, Board::maxSide*Board::maxSide> pending {};
+    for (int i = 0; i<board.size(); ++i)
+        pending[static_cast<std::size_t>(i)] = board.at(board.pointOf(i)).type == ContentT::StandardCandy;
+    auto isPending = [&](const Point &q) { return pending[static_cast<std::size_t>(indexOf(q))]; };
+
+    for (auto &q: plant) {
+        board.at(q).color = static_cast<CandyColor>(color);
+        pending[static_cast<std::size_t>(indexOf(q))] = false;
+    }
+    counts[static_cast<std::size_t>(color)] -= 3;
+
+    for (int i = 0; i<board.size(); ++i) {
+        if (!pending[static_cast<std::size_t>(i)])
+            continue;
+        const Point q {board.pointOf(i)};
+        const std::uint32_t out {ruledOut(q, isPending)};
+
+        int left {0};
+        for (int c = 0; c<maxColors; ++c)
+            if (!(out >> c & 1u))
+                left += counts[static_cast<std::size_t>(c)];
+        if (left == 0)
+            return false;
+
+        // The n-th candy left among the colours that aren't ruled out
+        int n {random.below(left)};
+        int c {0};
+        for (;; ++c) {
+            if (out >> c & 1u)
+                continue;
+            n -= counts[static_cast<std::size_t>(c)];
+            if (n < 0)
+                break;
+        }
+        board.at(q).color = static_cast<CandyColor>(c);
+        --counts[static_cast<std::size_t>(c)];
+        pending[static_cast<std::size_t>(i)] = false;
+    }
+
+    BitBoard bits {board};
+    return !bits.hasCombination() && MoveFinder{bits}.hasMove();
+}
@@ -0,0 +1,80 @@
+#ifndef CANDY_GENERATOR_HPP
+#define CANDY_GENERATOR_HPP
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+#include "board.hpp"
+#include "point.hpp"
+#include "random.hpp"
+#include "tile.hpp"
+
+/**
+ * Draws the colours of standard candies so that none of them
+ * is part of a combination
+ *
+ * Tiles are coloured in a single pass, in row-major order. For
+ * each one, the colours that would make a run of three with the
+ * tiles already settled around it (the ones coloured before it,
+ * i.e. its left and below neighbours, and the ones that aren't
+ * to be coloured) are ruled out first, then one of the others is
+ * drawn. No colour is drawn twice and no combination is looked
+ * for, unlike drawing colours until the tile isn't in one.
+ *
+ * Every colour can only be ruled out with very few colours (two,
+ * or three with special candies around), any is then drawn.
+ *
+ * Only uses the board and the generator, so boards can be
+ * generated from several threads, each with its own generator.
+ *
+ * @param board the board to colour
+ * @param random draws the colours
+ */
+class CandyGenerator
+{
+    private:
+        static constexpr int maxColors {6};  // see CandyColor
+        using Counts = std::array<int, maxColors>;
+
+        Board &board;
+        Random &random;
+
+        int indexOf(const Point &p) const { return p.y*board.colCount() + p.x; }
+
+        template<typename IsTarget>
+        void generate(IsTarget isTarget);
+
+        template<typename IsPending>
+        std::uint32_t ruledOut(const Point &p, IsPending isPending) const;
+
+        /// Candies of a planted move: the two of the run, then the one to swap
+        using Plant = std::array<Point, 3>;
+
+        std::optional<Plant> plantAt(int site) const;
+        bool shuffleAround(const Plant &plant, int color, Counts counts);
+    public:
+        CandyGenerator(Board &board, Random &random) noexcept
+            : board{board}, random{random}
+        { }
+
+        /// Puts standard candies on the empty tiles
+        void fillEmpty();
+
+        /// Draws a new colour for every standard candy
+        void recolor();
+
+        /**
+         * Permutes the colours of the standard candies so that
+         * none is part of a combination and a move is possible
+         *
+         * Moves are planted at sites drawn at random, a few times
+         * at most, so the time taken is bounded.
+         *
+         * @return false, with the board left as it was, if no
+         *         such permutation was found
+         */
+        bool shuffle();
+};
+
+#endif // CANDY_GENERATOR_HPP
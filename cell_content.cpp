@@ -40,20 +40,21 @@ void CellContent::draw()
  * ClearableCellContent
  *--------------------------------------------------------*/
 
+/**
+ * Only a base: the shape is given to CellContent by
+ * the most derived class, which is the one building it
+ */
 ClearableCellContent::ClearableCellContent(
         Grid &grid,
         Cell *cell,
-        std::shared_ptr<Shape> drawable,
         bool clearableByOther
         )
     :
-        CellContent{
-            grid,
-            cell,
-            drawable
-        },
+        CellContent{grid, cell, nullptr},  // never used, see above
         clearableByOther{clearableByOther}
-{ }
+{
+    m_clearable = this;
+}
 
 void ClearableCellContent::draw()
 {
@@ -66,26 +67,29 @@ void ClearableCellContent::draw()
 
 void ClearableCellContent::clearWithoutEffect()
 {
-    m_isClearing = true;
-    addAnimation(std::make_shared<ScaleAnimation>(20));
+    m_tile.set(Tile::Clearing);
+    grid.contentStateChanged(containerCell->getIndex());
+    addAnimation(grid.pool().make<ScaleAnimation>(CLEAR_TIME));
 }
 
 void ClearableCellContent::clear()
 {
     clearWithoutAnimation();
-    addAnimation(std::make_shared<ScaleAnimation>(20));
+    addAnimation(grid.pool().make<ScaleAnimation>(CLEAR_TIME));
 }
 
 void ClearableCellContent::clearWithoutAnimation()
 {
-    m_isClearing = true;
+    m_tile.set(Tile::Clearing);
+    grid.contentStateChanged(containerCell->getIndex());
 }
 
 void ClearableCellContent::animationFinished(AnimationT animationType)
 {
     if (animationType == AnimationT::ScaleAnimation) {
         clearFinished = true;
-        m_isClearing = false;
+        m_tile.unset(Tile::Clearing);
+        grid.contentStateChanged(containerCell->getIndex());
     }
 }
 
@@ -93,18 +97,16 @@ void ClearableCellContent::animationFinished(AnimationT animationType)
  * MovableCellContent
  *--------------------------------------------------------*/
 
+/// Only a base, as ClearableCellContent
 MovableCellContent::MovableCellContent(
         Grid &grid,
-        Cell *cell,
-        std::shared_ptr<Shape> drawable
+        Cell *cell
         )
     :
-        CellContent{
-            grid,
-            cell,
-            drawable
-        }
-{ }
+        CellContent{grid, cell, nullptr}
+{
+    m_movable = this;
+}
 
 void MovableCellContent::draw()
 {
@@ -118,7 +120,21 @@ void MovableCellContent::draw()
 void MovableCellContent::moveTo(const Point &point)
 {
     moveToWithoutAnimation(point);
-    addAnimation(std::make_shared<MoveAnimation>(ANIM_TIME, getCenter(), grid.at(point).getCenter()));
+    addAnimation(grid.pool().make<MoveAnimation>(ANIM_TIME, getCenter(), grid.at(point).getCenter()));
+}
+
+/**
+ * Moves to the last cell of the path, going through the others
+ */
+void MovableCellContent::moveAlong(const std::vector<Point> &path)
+{
+    std::vector<Point> waypoints {getCenter()};
+    waypoints.reserve(path.size()+1);
+    for (auto &p: path)
+        waypoints.push_back(grid.at(p).getCenter());
+
+    moveToWithoutAnimation(path.back());
+    addAnimation(grid.pool().make<MoveAnimation>(ANIM_TIME*static_cast<int>(path.size()), std::move(waypoints)));
 }
 
 void MovableCellContent::moveToWithoutAnimation(const Point &point)
@@ -145,17 +161,13 @@ void MovableCellContent::animationFinished(AnimationT a)
  * MatchableCellContent
  *--------------------------------------------------------*/
 
+/// Only a base, as ClearableCellContent
 MatchableCellContent::MatchableCellContent(
         Grid &grid,
-        Cell *cell,
-        std::shared_ptr<Shape> drawable
+        Cell *cell
         )
     :
-        CellContent{
-            grid,
-            cell,
-            drawable
-        }
+        CellContent{grid, cell, nullptr}
 { }
 
 /*----------------------------------------------------------
@@ -172,9 +184,11 @@ Wall::Wall(
         CellContent{
             grid,
             cell,
-            std::make_shared<Rectangle>(center, side, side, FL_BLACK)
+            grid.pool().make<Rectangle>(center, side, side, FL_BLACK)
         }
-{ }
+{
+    m_tile.type = ContentT::Wall;
+}
 
 /*----------------------------------------------------------
  * Icing
@@ -192,23 +206,21 @@ Icing::Icing(
         CellContent{
             grid,
             cell,
-            std::make_shared<Rectangle>(center, side, side, FL_CYAN)
-        },
-        ClearableCellContent{
-            grid,
-            cell,
-            std::make_shared<Rectangle>(center, side, side, FL_CYAN),
-            true
+            grid.pool().make<Rectangle>(center, side, side, FL_CYAN)
         },
-        layers{layers},
+        ClearableCellContent{grid, cell, true},
         num{center, std::to_string(layers)}
-{ }
+{
+    m_tile.type = ContentT::Icing;
+    m_tile.layers = static_cast<std::uint8_t>(layers);
+}
 
 void Icing::removeLayer()
 {
-    assert(layers>0);
-    --layers;
-    num.setString(std::to_string(layers));
+    assert(m_tile.layers>0);
+    --m_tile.layers;
+    num.setString(std::to_string(getLayers()));
+    grid.contentChanged(containerCell->getIndex());
     grid.update(Event::IcingCleared);
 }
 
@@ -231,7 +243,7 @@ void Icing::update(Event e)
 {
     switch (e) {
         case Event::NeighbourMatched:
-            if (layers>0 && !isClearing())
+            if (getLayers()>0 && !isClearing())
                 clear();
             break;
         default:
@@ -255,11 +267,13 @@ StandardCandy::StandardCandy(
             cell,
             shape
         },
-        ClearableCellContent{grid, cell, shape, true},
-        MovableCellContent{grid, cell, shape},
-        MatchableCellContent{grid, cell, shape},
-        color{color}
-{ }
+        ClearableCellContent{grid, cell, true},
+        MovableCellContent{grid, cell},
+        MatchableCellContent{grid, cell}
+{
+    m_tile.type = ContentT::StandardCandy;
+    m_tile.color = color;
+}
 
 StandardCandy::StandardCandy(
         Grid &grid,
@@ -273,7 +287,7 @@ StandardCandy::StandardCandy(
             cell,
             center,
             side,
-            static_cast<StandardCandy::Color>(std::rand()%6)  // if no color provided, pick random
+            static_cast<StandardCandy::Color>(grid.random().below(6))  // if no color provided, pick random
         }
 { }
 
@@ -288,7 +302,7 @@ StandardCandy::StandardCandy(
             grid,
             cell,
             color,
-            std::make_shared<Rectangle>(center, side, side, flRelative[static_cast<int>(color)])
+            grid.pool().make<Rectangle>(center, side, side, flRelative[static_cast<int>(color)])
         }
 { }
 
@@ -328,8 +342,8 @@ void StandardCandy::clearWithoutAnimation()
 
 bool StandardCandy::hasMatchWith(const Point &point) const
 {
-    std::shared_ptr<StandardCandy> other {std::dynamic_pointer_cast<StandardCandy>(grid.at(point).getContent())};
-    return other && getColor() == other->getColor();
+    const auto &other {grid.at(point).getContent()};
+    return other && m_tile.matches(other->tile());
 }
 
 /*----------------------------------------------------------
@@ -348,16 +362,13 @@ StripedCandy::StripedCandy(
         CellContent{
             grid,
             cell,
-            std::make_shared<StripedRectangle>(center, side, side, axis, flRelative[static_cast<int>(color)])
+            grid.pool().make<StripedRectangle>(center, side, side, axis, flRelative[static_cast<int>(color)])
         },
-        StandardCandy{
-            grid,
-            cell,
-            color,
-            std::make_shared<StripedRectangle>(center, side, side, axis, flRelative[static_cast<int>(color)])
-        },
-        axis{axis}
-{ }
+        StandardCandy{grid, cell, color, nullptr}  // the shape is the one above
+{
+    m_tile.type = ContentT::StripedCandy;
+    m_tile.axis = axis;
+}
 
 StripedCandy::StripedCandy(
         Grid &grid,
@@ -372,7 +383,7 @@ StripedCandy::StripedCandy(
             center,
             side,
             color,
-            static_cast<Axis>(std::rand()%2)  // if no axis provided, pick random
+            grid.random().coin() ? Axis::Horizontal : Axis::Vertical  // if no axis provided, pick random
         )
 { }
 
@@ -391,44 +402,37 @@ void StripedCandy::doubleStripedClear()
 {
     StandardCandy::clearWithoutAnimation();
 
-    for (unsigned i=0; i<grid.colCount(); ++i) {
-        grid.clearCell(Point{static_cast<int>(i), containerCell->getIndex().y});
-    }
-    for (unsigned i=0; i<grid.rowCount(); ++i) {
-        grid.clearCell(Point{containerCell->getIndex().x, static_cast<int>(i)});
-    }
+    const Point index {containerCell->getIndex()};
+    for (auto &p: grid.geometry().row(index.y))
+        grid.clearCell(p);
+    for (auto &p: grid.geometry().column(index.x))
+        grid.clearCell(p);
 }
 
 void StripedCandy::wrappedWithStripedClear()
 {
     StandardCandy::clearWithoutAnimation();
 
-    for (auto &p: {Point{-1, 0}, Point{0, 0}, Point{1, 0}}) {
-        Point decal {containerCell->getIndex() + p};
-        if (grid.isIndexValid(decal))
-            for (unsigned y=0; y<grid.rowCount(); ++y)
-                grid.clearCell({decal.x, static_cast<int>(y)});
-    }
-
-    for (auto &p: {Point{0, -1}, Point{0, 0}, Point{0, 1}}) {
-        Point decal {containerCell->getIndex() + p};
-        if (grid.isIndexValid(decal))
-            for (unsigned x=0; x<grid.rowCount(); ++x)
-                grid.clearCell({static_cast<int>(x), decal.y});
-    }
+    // Lines out of the grid are empty
+    const Point index {containerCell->getIndex()};
+    for (int d = -1; d <= 1; ++d)
+        for (auto &p: grid.geometry().column(index.x + d))
+            grid.clearCell(p);
+    for (int d = -1; d <= 1; ++d)
+        for (auto &p: grid.geometry().row(index.y + d))
+            grid.clearCell(p);
 }
 
 void StripedCandy::regularClear()
 {
     StandardCandy::clearWithoutAnimation();
-    if (axis == Axis::Horizontal) {
-        for (unsigned i=0; i<grid.colCount(); ++i) {
-            grid.clearCell(Point{static_cast<int>(i), containerCell->getIndex().y});
-        }
-    } else if (axis == Axis::Vertical) {
-        for (unsigned i=0; i<grid.rowCount(); ++i) {
-            grid.clearCell(Point{containerCell->getIndex().x, static_cast<int>(i)});
-        }
+    const Point index {containerCell->getIndex()};
+    if (m_tile.axis == Axis::Horizontal) {
+        for (auto &p: grid.geometry().row(index.y))
+            grid.clearCell(p);
+    } else if (m_tile.axis == Axis::Vertical) {
+        for (auto &p: grid.geometry().column(index.x))
+            grid.clearCell(p);
     }
 }
 
@@ -436,16 +440,17 @@ void StripedCandy::wasSwappedWith(const Point &p)
 {
     if (!containerCell->isLastSelected()) { return; }
 
-    std::shared_ptr<StripedCandy> striped {std::dynamic_pointer_cast<StripedCandy>(grid.at(p).getContent())};
-    std::shared_ptr<WrappedCandy> wrapped {std::dynamic_pointer_cast<WrappedCandy>(grid.at(p).getContent())};
+    auto &other {grid.at(p).getContent()};
+    bool striped {other && other->getType() == ContentT::StripedCandy};
+    bool wrapped {other && other->getType() == ContentT::WrappedCandy};
 
     if (striped) {      // case other is a stripped
         doubleStriped = true;
-        striped->clearWithoutEffect();  // clears the other striped like it is a standard candy
+        other->asClearable()->clearWithoutEffect();  // clears the other striped like it is a standard candy
         clear();
     } else if (wrapped) {   // case wrapped candy
         wrappedWithStriped = true;
-        wrapped->clearWithoutEffect();  // clears the other wrapped like it is a standard candy
+        other->asClearable()->clearWithoutEffect();  // clears the other wrapped like it is a standard candy
         clear();
     }
 }
@@ -465,15 +470,12 @@ WrappedCandy::WrappedCandy(
         CellContent{
             grid,
             cell,
-            std::make_shared<Star>(center, side, side, flRelative[static_cast<int>(color)])
+            grid.pool().make<Star>(center, side, side, flRelative[static_cast<int>(color)])
         },
-        StandardCandy{
-                grid,
-                cell,
-                color,
-                std::make_shared<Star>(center, side, side, flRelative[static_cast<int>(color)])
-        }
-{ }
+        StandardCandy{grid, cell, color, nullptr}  // the shape is the one above
+{
+    m_tile.type = ContentT::WrappedCandy;
+}
 
 void WrappedCandy::clear()
 {
@@ -514,71 +516,49 @@ void WrappedCandy::doubleWrappedClear()
 {
     StandardCandy::clearWithoutAnimation();
 
-    for (int x = -2; x <= 2; x++) {
-        for (int y = -2; y <= 2; y++) {
-            Point p{x, y};
-            try {
-                grid.clearCell(p+containerCell->getIndex());
-            } catch (const std::out_of_range& err) {}
-        }
-    }
+    for (auto &p: grid.geometry().square(containerCell->getIndex(), 2))
+        grid.clearCell(p);
 }
 
 void WrappedCandy::wrappedWithStripedClear()
 {
     clearWithoutEffect();
 
-    for (auto &p: {Point{-1, 0}, Point{0, 0}, Point{1, 0}}) {
-        Point decal {containerCell->getIndex() + p};
-        if (grid.isIndexValid(decal))
-            for (unsigned y=0; y<grid.rowCount(); ++y)
-                grid.clearCell({decal.x, static_cast<int>(y)});
-    }
-
-    for (auto &p: {Point{0, -1}, Point{0, 0}, Point{0, 1}}) {
-        Point decal {containerCell->getIndex() + p};
-        if (grid.isIndexValid(decal))
-            for (unsigned x=0; x<grid.rowCount(); ++x)
-                grid.clearCell({static_cast<int>(x), decal.y});
-    }
+    // Lines out of the grid are empty
+    const Point index {containerCell->getIndex()};
+    for (int d = -1; d <= 1; ++d)
+        for (auto &p: grid.geometry().column(index.x + d))
+            grid.clearCell(p);
+    for (int d = -1; d <= 1; ++d)
+        for (auto &p: grid.geometry().row(index.y + d))
+            grid.clearCell(p);
 }
 
 void WrappedCandy::regularClear()
 {
     StandardCandy::clearWithoutAnimation();
 
-    constexpr static std::array<Point, 8> directionModifier {
-            Point{ 0, -1},  // South
-            Point{ 0,  1},  // North
-            Point{-1,  0},  // West
-            Point{ 1,  0},  // East
-            Point{-1, -1},  // SouthWest
-            Point{ 1, -1},  // SouthEast
-            Point{-1,  1},  // NorthWest
-            Point{ 1,  1}   // NorthEast
-    };
-
-    for (auto &p: directionModifier) {
-        try {
-            grid.clearCell(p+containerCell->getIndex());
-        } catch (const std::out_of_range& err) {}
-    }
+    const Point index {containerCell->getIndex()};
+    for (auto &p: grid.geometry().square(index, 1))
+        if (!(p == index))
+            grid.clearCell(p);
 }
 
 void WrappedCandy::wasSwappedWith(const Point &p)
 {
     if (!containerCell->isLastSelected()) { return; }
 
-    std::shared_ptr<StripedCandy> striped {std::dynamic_pointer_cast<StripedCandy>(grid.at(p).getContent())};
-    std::shared_ptr<WrappedCandy> wrapped {std::dynamic_pointer_cast<WrappedCandy>(grid.at(p).getContent())};
+    auto &other {grid.at(p).getContent()};
+    bool striped {other && other->getType() == ContentT::StripedCandy};
+    bool wrapped {other && other->getType() == ContentT::WrappedCandy};
 
     if (striped) {      // case other is a stripped
         wrappedWithStriped = true;
-        striped->clearWithoutEffect();  // clears the other striped like it is a standard candy
+        other->asClearable()->clearWithoutEffect();  // clears the other striped like it is a standard candy
         clear();
     } else if (wrapped) {   // case wrapped candy
         doubleWrapped = true;
-        wrapped->clearWithoutEffect();  // clears the other wrapped like it is a standard candy
+        other->asClearable()->clearWithoutEffect();  // clears the other wrapped like it is a standard candy
         clear();
     }
 }
@@ -597,11 +577,18 @@ ColourBomb::ColourBomb(
         CellContent{
                 grid,
                 cell,
-                std::make_shared<MulticolourCircle>(center, side)
+                grid.pool().make<MulticolourCircle>(center, side)
         },
-        ClearableCellContent{grid, cell, std::make_shared<MulticolourCircle>(center, side), true},
-        MovableCellContent{grid, cell, std::make_shared<MulticolourCircle>(center, side)}
-{ }
+        ClearableCellContent{grid, cell, true},
+        MovableCellContent{grid, cell}
+{
+    m_tile.type = ContentT::ColourBomb;
+}
+
+StandardCandy::Color ColourBomb::getColorToClear()
+{
+    return static_cast<StandardCandy::Color>(grid.random().below(6));
+}
 
 void ColourBomb::draw()
 {
@@ -630,8 +617,7 @@ void ColourBomb::replaceAndExplode()
     // case other is standard, striped or wrapped
     for (auto &c: grid) {
         if (!c.isEmpty() && c.getContent()->getType() == ContentT::StandardCandy) {
-            StandardCandy::Color cellColor{
-                    std::dynamic_pointer_cast<StandardCandy>(c.getContent())->getColor()};
+            StandardCandy::Color cellColor{c.getContent()->tile().color};
             if (cellColor == colorToReplace) {
                 // place the specific candy
                 c.clearWithoutAnimation();
@@ -641,10 +627,9 @@ void ColourBomb::replaceAndExplode()
     }
 
     for (auto &c: grid) {
-        // the next cast test is to avoid calling getColor() on contents that don't have a color
-        if (!c.isEmpty() && std::dynamic_pointer_cast<StandardCandy>(c.getContent())) {
-            StandardCandy::Color cellColor{
-                    std::dynamic_pointer_cast<StandardCandy>(c.getContent())->getColor()};
+        // the candy test is to avoid reading the color of contents that don't have one
+        if (!c.isEmpty() && c.getContent()->tile().isCandy()) {
+            StandardCandy::Color cellColor{c.getContent()->tile().color};
             if (cellColor == colorToReplace) {
                 // explode all specific candies
                 grid.clearCell(c.getIndex());
@@ -664,19 +649,20 @@ void ColourBomb::clearWithoutAnimation()
 
 void ColourBomb::wasSwappedWith(const Point &p)
 {
-    std::shared_ptr<StandardCandy> otherCandy {std::dynamic_pointer_cast<StandardCandy>(grid.at(p).getContent())};
-    std::shared_ptr<ColourBomb> otherBomb {std::dynamic_pointer_cast<ColourBomb>(grid.at(p).getContent())};
+    auto &other {grid.at(p).getContent()};
+    bool otherCandy {other && other->tile().isCandy()};
+    bool otherBomb {other && other->getType() == ContentT::ColourBomb};
 
     // case StandardCandy, StripedCandy, WrappedCandy
     if (otherCandy) {
-        colorToReplace = otherCandy->getColor();
-        typeToReplaceWith = otherCandy->getType();
+        colorToReplace = other->tile().color;
+        typeToReplaceWith = other->getType();
         wasSwapped = true;
         clear();
 
     // case ColourBomb
     } else if (otherBomb && !hasAnimation()) {    // checking animation to prevent both bombs to explode
-        typeToReplaceWith = otherBomb->getType();
+        typeToReplaceWith = other->getType();
         wasSwapped = true;
         clear();
     }
@@ -1,25 +1,18 @@
 #ifndef CELL_CONTENT_HPP
 #define CELL_CONTENT_HPP
 
-#include <random>
-
 #include "common.hpp"
 #include "point.hpp"
 #include "shape.hpp"
 #include "event.hpp"
+#include "tile.hpp"
 
 // Classes from grid.hpp
 class Grid;
 class Cell;
 
-enum class ContentT {
-    StandardCandy,
-    StripedCandy,
-    WrappedCandy,
-    ColourBomb,
-    Wall,
-    Icing
-};
+class ClearableCellContent;
+class MovableCellContent;
 
 /**
  * CellContent, base class of everything that can go on a Cell
@@ -27,9 +20,11 @@ enum class ContentT {
  * @param grid grid the cell (on wich the content is put) is part of
  * @param cell cell on which the content is put
  * @param drawable the shape of the content
- * @param movable should the content be moved
- * @param matchable can the content be matched with others
- * @param clearable should it be clearable
+ *
+ * What the content is and can do (movable, matchable, clearable,
+ * its color, ...) is described by a Tile, set by the constructors
+ * of derived classes. Testing it is much cheaper than casting
+ * the content to find out.
  */
 class CellContent : public DrawableContainer
 {
@@ -39,6 +34,12 @@ class CellContent : public DrawableContainer
 
         bool m_isPulsing {false};
         bool m_pulseFinished {false};
+
+        Tile m_tile {};
+
+        // Set by the capability classes, so that no cast is needed
+        ClearableCellContent *m_clearable {nullptr};
+        MovableCellContent *m_movable {nullptr};
     public:
         CellContent(Grid &grid, Cell *cell, std::shared_ptr<Shape> drawable);
 
@@ -49,7 +50,15 @@ class CellContent : public DrawableContainer
 
         virtual void update(Event) { }
 
-        virtual ContentT getType() = 0;
+        ContentT getType() const { return m_tile.type; }
+
+        /// Description of the content, also used by the board model
+        const Tile &tile() const { return m_tile; }
+        bool isClearing() const { return m_tile.has(Tile::Clearing); }
+
+        // nullptr if the content doesn't have the capability
+        ClearableCellContent *asClearable() { return m_clearable; }
+        MovableCellContent *asMovable() { return m_movable; }
 
         void draw() override;
 
@@ -62,8 +71,6 @@ class Wall : public CellContent
 {
     public:
         Wall(Grid &grid, Cell *cell, const Point &center, int side);
-
-        ContentT getType() override { return ContentT::Wall; }
 };
 
 // A CellContent object that is matchable should be
@@ -76,11 +83,11 @@ class ClearableCellContent : public virtual CellContent
 
         // Animations states
         bool clearFinished = false;
-        bool m_isClearing = false;
 
         bool clearAtFallEnd{false};
+
+        ClearableCellContent(Grid &grid, Cell *cell, bool clearableByOther);
     public:
-        ClearableCellContent(Grid &grid, Cell *cell, std::shared_ptr<Shape> drawable, bool clearableByOther);
 
         void draw() override;
 
@@ -88,9 +95,6 @@ class ClearableCellContent : public virtual CellContent
         virtual void clear();
         virtual void clearWithoutAnimation();
 
-        // State of animation
-        bool isClearing() { return m_isClearing; }
-
         void animationFinished(AnimationT a) override;
 
         virtual void update(Event) override
@@ -108,12 +112,11 @@ class ClearableCellContent : public virtual CellContent
 class Icing : public ClearableCellContent
 {
     private:
-        int layers;
         Text num;
     public:
         Icing(Grid &grid, Cell *cell, const Point &center, int side, int layers = 2);
 
-        int getLayers() const { return layers; }
+        int getLayers() const { return m_tile.layers; }
         void removeLayer();
 
         void clear() override;
@@ -121,7 +124,6 @@ class Icing : public ClearableCellContent
 
         void draw() override;
 
-        ContentT getType() override { return ContentT::Icing; }
 };
 
 class MovableCellContent : public virtual CellContent
@@ -130,13 +132,15 @@ class MovableCellContent : public virtual CellContent
         // Animations states
         bool moveFinished = false;
         bool m_isMoving = false;
+
+        MovableCellContent(Grid &grid, Cell *cell);
     public:
-        MovableCellContent(Grid &grid, Cell *cell, std::shared_ptr<Shape> drawable);
 
         void draw() override;
 
         virtual void moveTo(const Point &point);
         virtual void moveToWithoutAnimation(const Point &point);
+        virtual void moveAlong(const std::vector<Point> &path);
 
         virtual void wasSwappedWith(const Point &p);
 
@@ -152,8 +156,9 @@ class MovableCellContent : public virtual CellContent
  */
 class MatchableCellContent : public virtual CellContent
 {
+    protected:
+        MatchableCellContent(Grid &grid, Cell *cell);
     public:
-        MatchableCellContent(Grid &grid, Cell *cell, std::shared_ptr<Shape> drawable);
 
         virtual bool hasMatchWith(const Point &point) const = 0;
 };
@@ -174,20 +179,10 @@ class MatchableCellContent : public virtual CellContent
 class StandardCandy : public ClearableCellContent, public MovableCellContent, public MatchableCellContent
 {
     public:
-        // This is different than FL colors
-        // because only these are permitted.
-        enum class Color {
-            Blue,
-            Green,
-            Cyan,
-            Magenta,
-            Red,
-            Yellow
-        };
+        using Color = CandyColor;
     protected:
-        Color color;  // identifier of a candy
-
-        // This constructor is for derived classes to change appearance of candy
+        // This constructor is for derived classes to change appearance of candy.
+        // Those give their shape to CellContent themselves, and nullptr here.
         StandardCandy(Grid &grid, Cell *cell, Color color, std::shared_ptr<AnimatableShape> shape);
     public:
         StandardCandy(Grid &grid, Cell *cell, Point center, int side);
@@ -200,18 +195,14 @@ class StandardCandy : public ClearableCellContent, public MovableCellContent, pu
         void animationFinished(AnimationT a) override;
 
         // Getters
-        Color getColor() const { return color; }
+        Color getColor() const { return m_tile.color; }
 
         void clearWithoutAnimation() override;
-
-        ContentT getType() override { return ContentT::StandardCandy; }
 };
 
 class StripedCandy : public StandardCandy
 {
     protected:
-        Axis axis;  // wether horizontal or vertical
-
         // clearWithoutAnimation uses this to know the way he must explode
         bool doubleStriped {false};
         bool wrappedWithStriped {false};
@@ -227,8 +218,6 @@ class StripedCandy : public StandardCandy
         void clearWithoutAnimation() override;
 
         void wasSwappedWith(const Point &p) override;
-
-        ContentT getType() override { return ContentT::StripedCandy; }
 };
 
 class WrappedCandy : public StandardCandy
@@ -252,7 +241,6 @@ class WrappedCandy : public StandardCandy
         void wasSwappedWith(const Point &p) override;
 
         void update(Event e) override;
-        ContentT getType() override { return  ContentT::WrappedCandy; }
 };
 
 class ColourBomb : public ClearableCellContent, public MovableCellContent
@@ -265,7 +253,7 @@ class ColourBomb : public ClearableCellContent, public MovableCellContent
         void draw() override;
         void animationFinished(AnimationT a) override;
 
-        StandardCandy::Color getColorToClear() { return static_cast<StandardCandy::Color>(std::rand()%6); }
+        StandardCandy::Color getColorToClear();
 
         void replaceAndExplode();
     public:
@@ -274,8 +262,6 @@ class ColourBomb : public ClearableCellContent, public MovableCellContent
         void clearWithoutAnimation() override;
 
         void wasSwappedWith(const Point &p) override;
-
-        ContentT getType() override { return ContentT::ColourBomb; }
 };
 
 #endif
@@ -0,0 +1,118 @@
+#include "combination.hpp"
+
+#include <cassert>
+#include <stdexcept>
+
+/*----------------------------------------------------------
+ * Combination
+ *--------------------------------------------------------*/
+
+Combination::Combination(const Point &point)
+    : origin{point}
+{ }
+
+Point Combination::getOrigin() const
+{
+    return origin;
+}
+
+void Combination::setOrigin(const Point &orig)
+{
+    origin = orig;
+}
+
+bool Combination::isEmpty() const
+{
+    return horizontal.empty() && vertical.empty();
+}
+
+void Combination::addVerticalElement(const Point &elem)
+{
+    assert(elem.x == origin.x);
+    vertical.push_back(elem);
+}
+
+void Combination::addHorizontalElement(const Point &elem)
+{
+    assert(elem.y == origin.y);
+    horizontal.push_back(elem);
+}
+
+void Combination::addElement(const Point &elem, Direction direction)
+{
+    switch (direction) {
+        case Direction::South:
+        case Direction::North:
+            addVerticalElement(elem);
+            break;
+        case Direction::West:
+        case Direction::East:
+            addHorizontalElement(elem);
+            break;
+        default:
+            std::runtime_error("Combination: given direction is unsupported");
+    }
+}
+
+std::size_t Combination::getVerticalCount() const
+{
+    return vertical.size()+1;
+}
+
+std::size_t Combination::getHorizontalCount() const
+{
+    return horizontal.size()+1;
+}
+
+std::size_t Combination::getTotalCount() const
+{
+    std::size_t ret{ 0 };
+    ret += getHorizontalCount()>2 ? getHorizontalCount() : 0;
+    ret += getVerticalCount()>2 ? getVerticalCount() : 0;
+    return ret;
+}
+
+std::vector<Point> Combination::getVerticalElements() const
+{
+    return vertical;
+}
+
+std::vector<Point> Combination::getHorizontalElements() const
+{
+    return horizontal;
+}
+
+std::vector<Point> Combination::getAllElements() const
+{
+    std::vector<Point> ret;
+    ret.reserve(vertical.size() + horizontal.size());
+    ret.insert(ret.end(), vertical.begin(), vertical.end());
+    ret.insert(ret.end(), horizontal.begin(), horizontal.end());
+    return ret;
+}
+
+void Combination::removeVerticalElems()
+{
+      vertical.clear();
+}
+
+void Combination::removeHorizontalElems()
+{
+    horizontal.clear();
+}
+
+CombinationT Combination::type() const
+{
+    std::size_t vc = getVerticalCount();
+    std::size_t hc = getHorizontalCount();
+
+    if ((vc==3 && hc<3) || (hc==3 && vc<3))
+        return CombinationT::Line3;
+    else if ((vc==4 && hc<3) || (hc==4 && vc<3))
+        return CombinationT::Line4;
+    else if (vc>=3 && vc<5 && hc>=3 && hc<5)
+        return CombinationT::Cross;
+    else if (vc>=5 || hc>=5)
+        return CombinationT::Line5;
+    return CombinationT::None;
+}
@@ -0,0 +1,60 @@
+#ifndef COMBINATION_HPP
+#define COMBINATION_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "point.hpp"
+
+/**
+ * The special candy a combination results in, if any
+ */
+enum class CombinationT {
+    None,
+    Line3,      // 3 in one axis
+    Line4,      // 4 in one axis, gives a striped candy
+    Cross,      // 3 or 4 on both axis, gives a wrapped candy
+    Line5       // 5 or more in one axis, gives a colour bomb
+};
+
+/**
+ * Cells that form a combination around an origin
+ *
+ * The origin is not part of the elements, only the
+ * cells on its row (horizontal) and column (vertical).
+ */
+class Combination
+{
+    private:
+        Point origin;
+        std::vector<Point> vertical {};
+        std::vector<Point> horizontal {};
+    public:
+        Combination(const Point &point);
+
+        Point getOrigin() const;
+        void setOrigin(const Point &orig);
+
+        bool isEmpty() const;
+
+        void addVerticalElement(const Point &elem);
+        void addHorizontalElement(const Point &elem);
+        void addElement(const Point &elem, Direction direction);
+
+        // These include the origin
+        std::size_t getVerticalCount() const;
+        std::size_t getHorizontalCount() const;
+        std::size_t getTotalCount() const;
+
+        // These don't include the origin
+        std::vector<Point> getVerticalElements() const;
+        std::vector<Point> getHorizontalElements() const;
+        std::vector<Point> getAllElements() const;
+
+        void removeVerticalElems();
+        void removeHorizontalElems();
+
+        CombinationT type() const;
+};
+
+#endif // COMBINATION_HPP
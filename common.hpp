@@ -2,6 +2,7 @@
 #define COMMON_HPP
 
 /* #include <ostream> */
+#include <chrono>
 #include <memory>
 #include <cassert>
 
@@ -11,7 +12,9 @@ class Shape;    // inclusion not needed, this is faster
 
 
 // Constants
-const int ANIM_TIME = 10;
+const std::chrono::milliseconds ANIM_TIME {170};   // to move by one cell
+const std::chrono::milliseconds CLEAR_TIME {330};
+const std::chrono::milliseconds PULSE_TIME {330};
 
 /**
   Part of the program the user can interact with
@@ -30,6 +33,10 @@ struct Interactive
 
   Can have an animation
 
+  Keeps track of whether it changed since it was last drawn, so
+  that only what changed on the screen needs to be drawn again.
+  Changes made to the shape directly must be reported with damage().
+
   @param shape shape to be contained in the object
   */
 class DrawableContainer
@@ -37,6 +44,7 @@ class DrawableContainer
     protected:
         std::shared_ptr<Shape> drawable;
         std::shared_ptr<Animation> animation;
+        bool damaged {true};  // never drawn yet
     public:
         DrawableContainer(std::shared_ptr<Shape> shape) noexcept
             : drawable{shape}, animation{nullptr} { }
@@ -44,10 +52,11 @@ class DrawableContainer
 
         // Center
         Point getCenter() const { return drawable->getCenter(); }
-        void setCenter(const Point& p) { drawable->setCenter(p); }
+        void setCenter(const Point& p) { drawable->setCenter(p); damage(); }
 
         /// Draws the content
         virtual void draw() {
+            damaged = false;
             if (animation)
                 animation->draw();
             else
@@ -55,9 +64,21 @@ class DrawableContainer
             if (animation && animation->isComplete()) {
                 animationFinished(animation->type());
                 animation.reset();
+                damaged = true;  // to be drawn once more, at rest
             }
         }
 
+        // Damage, an animation damages on every frame
+        void damage() { damaged = true; }
+        void clearDamage() { damaged = false; }  // drawn by other means, e.g. from a picture
+        bool isDamaged() const { return damaged || animation; }
+
+        /// Whether the animation takes the drawable away from its place
+        bool isMoving() const
+        {
+            return animation && animation->type() == AnimationT::MoveAnimation;
+        }
+
         virtual bool hasAnimation() { return static_cast<bool>(animation); }
 
         virtual void addAnimation(std::shared_ptr<Animation> newanim)
@@ -71,19 +92,8 @@ class DrawableContainer
         }
 
         // Function called at end of an animation with the type of it
-        virtual void removeAnimation() { animation.reset(); }
+        virtual void removeAnimation() { animation.reset(); damage(); }
         virtual void animationFinished(AnimationT) { }
 };
 
-enum class Direction {
-    South,
-    North,
-    West,
-    East,
-    SouthWest,
-    SouthEast,
-    NorthWest,
-    NorthEast
-};
-
 #endif
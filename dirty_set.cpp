@@ -0,0 +1,40 @@
+#include "dirty_set.hpp"
+
+#include <algorithm>
+
+/*----------------------------------------------------------
+ * DirtySet
+ *--------------------------------------------------------*/
+
+DirtySet::DirtySet(int rows, int columns)
+    : columns{columns},
+      marked(static_cast<std::size_t>(rows*columns), 0),
+      points{}
+{ }
+
+/**
+ * Empties the set
+ *
+ * @return the cells that were marked, sorted in the order
+ *  a full scan of the board visits them (row by row from
+ *  the bottom), so results don't depend on marking order
+ */
+std::vector<Point> DirtySet::take()
+{
+    std::vector<Point> ret;
+    ret.swap(points);
+    for (auto &p: ret)
+        marked[indexOf(p)] = 0;
+
+    std::sort(ret.begin(), ret.end(), [](const Point &a, const Point &b) {
+            return a.y<b.y || (a.y==b.y && a.x<b.x);
+            });
+    return ret;
+}
+
+void DirtySet::clear()
+{
+    for (auto &p: points)
+        marked[indexOf(p)] = 0;
+    points.clear();
+}
@@ -0,0 +1,54 @@
+#ifndef DIRTY_SET_HPP
+#define DIRTY_SET_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "point.hpp"
+
+/**
+ * Set of cells whose content changed since it was last taken
+ *
+ * A new combination always contains at least one cell that
+ * changed, so looking for combinations only around those
+ * cells is enough once a fall is over, provided each one is
+ * looked at until it is cleared or in no combination: the
+ * combination found from a cell may be a bigger one next to
+ * it. Marking is O(1) and taking the set costs what was
+ * marked, not the board area.
+ *
+ * @param rows number of rows of the board
+ * @param columns number of columns of the board
+ */
+class DirtySet
+{
+    private:
+        int columns;
+        std::vector<std::uint8_t> marked;  // one entry per cell, row-major
+        std::vector<Point> points;         // marked cells, in marking order
+
+        std::size_t indexOf(const Point &p) const
+        {
+            return static_cast<std::size_t>(p.y*columns + p.x);
+        }
+    public:
+        DirtySet(int rows, int columns);
+
+        void mark(const Point &p)
+        {
+            std::uint8_t &m {marked[indexOf(p)]};
+            if (!m) {
+                m = 1;
+                points.push_back(p);
+            }
+        }
+
+        bool isMarked(const Point &p) const { return marked[indexOf(p)]; }
+        bool empty() const { return points.empty(); }
+        std::size_t size() const { return points.size(); }
+
+        std::vector<Point> take();
+        void clear();
+};
+
+#endif // DIRTY_SET_HPP
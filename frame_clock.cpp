@@ -0,0 +1,34 @@
+#include "frame_clock.hpp"
+
+#include <algorithm>
+
+/*----------------------------------------------------------
+ * FrameClock
+ *--------------------------------------------------------*/
+
+void FrameClock::tick()
+{
+    TimePoint now {Clock::now()};
+    Duration delta {nominal};  // nothing to measure the first frame from
+    if (m_started)
+        delta = std::chrono::duration_cast<Duration>(now - m_last);
+    m_started = true;
+    m_last = now;
+    m_delta = std::clamp(delta, Duration::zero(), maxDelta);
+}
+
+void FrameClock::tick(Duration delta)
+{
+    m_last += delta;
+    m_delta = std::clamp(delta, Duration::zero(), maxDelta);
+}
+
+/**
+ * While frames are drawn, the time of the current frame is at most
+ * a frame behind and is kept, so that input and drawing agree on it
+ */
+void FrameClock::sync()
+{
+    if (!m_started)
+        m_last = Clock::now();
+}
@@ -0,0 +1,62 @@
+#ifndef FRAME_CLOCK_HPP
+#define FRAME_CLOCK_HPP
+
+#include <chrono>
+
+/**
+ * Time taken by the last frame
+ *
+ * Animations and timers move forward by the time the last frame
+ * took instead of by one step per frame, so the game runs at the
+ * same speed whatever the frame rate. When drawing stalls, the
+ * next frame makes up for the lost time at once: frames are
+ * skipped, the game isn't slowed down.
+ *
+ * The time of the current frame is the clock timers are set
+ * against: something due at a given time is done by the first
+ * frame drawn after it (see State::nextDeadline).
+ *
+ * The window ticks the clock at the beginning of each frame, and
+ * resumes it when frames start again after it stopped drawing.
+ * Input may come long after the last frame while the window isn't
+ * drawing, the window syncs the clock before handling it.
+ * Drawing without a window should tick it with the time each frame
+ * is meant to take, e.g. nominal.
+ */
+class FrameClock
+{
+    public:
+        using Clock = std::chrono::steady_clock;
+        using Duration = std::chrono::microseconds;
+        using TimePoint = Clock::time_point;
+
+        static constexpr Duration nominal {1000000/60};
+        static constexpr Duration maxDelta {250000};  // longer stalls are lost, not caught up on
+    private:
+        static inline Duration m_delta {nominal};
+        static inline TimePoint m_last {Clock::now()};
+        static inline bool m_started {false};
+    public:
+        /// A new frame begins, measures the time since the last one
+        static void tick();
+
+        /// A new frame begins, the last one took the given time
+        static void tick(Duration delta);
+
+        /// Frames start again after a pause, which isn't to be caught up on
+        static void resume() { m_started = false; }
+
+        /**
+         * Input is about to be handled: if no frame is being drawn,
+         * the time of the current frame becomes the current time,
+         * so that timers set on input aren't set in the past
+         */
+        static void sync();
+
+        static Duration delta() { return m_delta; }
+
+        /// When the current frame began
+        static TimePoint now() { return m_last; }
+};
+
+#endif // FRAME_CLOCK_HPP
@@ -21,11 +21,12 @@ View::View(Fl_Window& win, Game& g)
  * Game
  *--------------------------------------------------------*/
 
-Game::Game(Fl_Window& win)
+Game::Game(Fl_Window& win, std::uint64_t seed)
     : window{win}
-    , view{std::make_shared<Level>(win, *this, "level1.txt")}
+    , m_random{seed}
+    , view{std::make_shared<Level>(win, *this, "level1.txt", m_random.nextSeed())}
     , bestScore {-1}
-    /* view{std::make_shared<SplashScreen>(win, *this, "Authors", 15, 120)} { } TODO */
+    /* view{std::make_shared<SplashScreen>(win, *this, "Authors", 15, std::chrono::seconds{2})} { } TODO */
 {
     std::ifstream scoreSrc {"best_score.txt"};
     if (scoreSrc) {
@@ -42,6 +43,13 @@ void Game::mouseClick(Point mouseLoc) { if(view) view->mouseClick(mouseLoc); }
 void Game::mouseDrag(Point mouseLoc)  { if(view) view->mouseDrag(mouseLoc); }
 
 void Game::draw() { if(view) view->draw(); }
+void Game::drawDamaged() { if(view) view->drawDamaged(); }
+bool Game::isIdle() { return !view || view->isIdle(); }
+
+std::optional<FrameClock::TimePoint> Game::nextDeadline() const
+{
+    return view ? view->nextDeadline() : std::nullopt;
+}
 
 void Game::loadView(std::shared_ptr<View> v)
 {
@@ -77,7 +85,7 @@ SplashScreen::SplashScreen(
         Game& game,
         std::string authors,
         int fontSize,
-        int duration
+        std::chrono::milliseconds duration
         )
     : View{win, game},
     author{std::make_shared<Text>(Point{win.w()/2, win.h()/2}, authors, fontSize)}
@@ -90,7 +98,7 @@ void SplashScreen::draw()
     DrawableContainer::draw();  // draw the background
     author.draw();              // draw the author's name
     if (toBeReplaced)
-        game.loadView(std::make_shared<Level>(window, game, "level1.txt"));
+        game.loadView(std::make_shared<Level>(window, game, "level1.txt", game.nextLevelSeed()));
 }
 
 void SplashScreen::animationFinished(AnimationT animationType)
@@ -187,11 +195,12 @@ void SplashScreen::animationFinished(AnimationT animationType)
  *--------------------------------------------------------*/
 
 // TODO make adaptable to height
-Level::Level(Fl_Window& window, Game& game, const std::string &filename)
+Level::Level(Fl_Window& window, Game& game, const std::string &filename, std::uint64_t seed)
     : View{window, game},
     m_data{filename},
     m_status{Point{window.w()/2, window.h()/12*11}, gridSide(window), gridSide(window)/5, m_data},
-    m_board{Point{window.w()/2, window.h()/12*5}, gridSide(window), gridSide(window), m_data},
+    m_random{seed},
+    m_board{Point{window.w()/2, window.h()/12*5}, gridSide(window), gridSide(window), m_data, m_random, m_pool},
     m_boardController{nullptr}
 {
     m_status.registerObserver(this);
@@ -213,15 +222,40 @@ void Level::draw()
     m_boardController->draw();
 }
 
+/**
+ * The level is drawn whole after a change of state,
+ * otherwise only the cells and status that changed
+ */
+void Level::drawDamaged()
+{
+    if (isDamaged()) {
+        draw();
+        return;
+    }
+    m_board.drawDamaged();
+    if (m_status.isDamaged())
+        m_status.draw();
+    m_boardController->draw();
+}
+
+bool Level::isIdle()
+{
+    return !isDamaged()
+        && !m_status.isDamaged()
+        && m_board.isIdle()
+        && m_boardController->isIdle();
+}
+
 void Level::setState(std::shared_ptr<State> state)
 {
+    damage();  // e.g. a message to be erased
     m_boardController = state;
     m_board.setState(state);
 }
 
 void Level::replayLevel()
 {
-    game.loadView(std::make_shared<Level>(window, game, m_data.levelName()));
+    game.loadView(std::make_shared<Level>(window, game, m_data.levelName(), game.nextLevelSeed()));
 }
 
 // TODO: implement it
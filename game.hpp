@@ -2,7 +2,9 @@
 #define GAME_H
 
 #include <FL/Fl_Window.H>
+#include <cstdint>
 #include <memory>
+#include <optional>
 /* #include <iostream> */
 /* #include <fstream> */
 /* #include <sstream> */
@@ -14,6 +16,8 @@
 /* #include "level_goal.hpp" */
 #include "level_status.hpp"
 #include "level_data.hpp"
+#include "random.hpp"
+#include "turn_check.hpp"
 
 class Game;
 
@@ -42,31 +46,51 @@ class View : public DrawableContainer, public Interactive
 
         int w() const { return window.w(); }
         int h() const { return window.h(); }
+
+        /// Draws what changed since the last frame, everything by default
+        virtual void drawDamaged() { draw(); }
+
+        /// Whether drawing would change nothing on the screen
+        virtual bool isIdle() { return !isDamaged(); }
+
+        /// When a frame is needed next while idle, if ever
+        virtual std::optional<FrameClock::TimePoint> nextDeadline() const { return std::nullopt; }
 };
 
 /**
  * A game, holds the different views of the game
+ *
+ * Each level gets its own seed from the generator of the game,
+ * so a whole session can be replayed from the seed given here.
+ *
+ * @param seed seed of the session
  */
 class Game : public Interactive
 {
     private:
         Fl_Window& window;
+        Random m_random;  // gives the seed of each level
         std::shared_ptr<View> view;
         int bestScore;
         void writeScore();
     public:
-        Game(Fl_Window& win);
+        Game(Fl_Window& win, std::uint64_t seed);
 
         void mouseMove(Point mouseLoc) override;
         void mouseClick(Point mouseLoc) override;
         void mouseDrag(Point mouseLoc) override;
 
         void draw();
+        void drawDamaged();
+        bool isIdle();
+        std::optional<FrameClock::TimePoint> nextDeadline() const;
 
         void loadView(std::shared_ptr<View> v);
 
         void updateScore(int);
         void resetScore();
+
+        std::uint64_t nextLevelSeed() { return m_random.nextSeed(); }
 };
 
 /**
@@ -84,7 +108,7 @@ class SplashScreen : public View
         DrawableContainer author;
         bool toBeReplaced = false;  // Whether or not the next screen should be loaded
     public:
-        SplashScreen(Fl_Window& window, Game& game, std::string author, int fontSize, int duration);
+        SplashScreen(Fl_Window& window, Game& game, std::string author, int fontSize, std::chrono::milliseconds duration);
 
         // Mouse interactions are disabled
         void mouseMove(Point) override { }
@@ -148,20 +172,29 @@ class SplashScreen : public View
 class Level : public View, public Subject, public Observer
 {
     private:
+        ObjectPool m_pool {};  // first in, last out: outlives all it made
         LevelData m_data;
         LevelStatus m_status;
+        Random m_random;  // everything random in the level comes from here
         Grid m_board;
+        TurnCheck m_turnCheck {m_board.model()};
         std::shared_ptr<State> m_boardController {nullptr};
 
         inline int gridSide(Fl_Window &win);
     public:
-        Level(Fl_Window& window, Game& game, const std::string &filename);
+        Level(Fl_Window& window, Game& game, const std::string &filename, std::uint64_t seed);
 
         void mouseMove(Point mouseLoc)  override { m_boardController->mouseMove(mouseLoc); }
         void mouseClick(Point mouseLoc) override { m_boardController->mouseClick(mouseLoc); }
         void mouseDrag(Point mouseLoc)  override { m_boardController->mouseDrag(mouseLoc); }
 
         void draw() override;
+        void drawDamaged() override;
+        bool isIdle() override;
+        std::optional<FrameClock::TimePoint> nextDeadline() const override
+        {
+            return m_boardController->nextDeadline();
+        }
 
         void setState(std::shared_ptr<State> state);
         void replayLevel();
@@ -169,6 +202,9 @@ class Level : public View, public Subject, public Observer
 
         void update(Event event) override;
         void updateScore(int toAdd) { m_status.updateScore(toAdd); }
+        int score() const { return m_status.score(); }
+
+        TurnCheck &turnCheck() { return m_turnCheck; }
 };
 
 #endif
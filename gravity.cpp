@@ -0,0 +1,96 @@
+#include "gravity.hpp"
+
+#include <utility>
+
+/*----------------------------------------------------------
+ * Gravity
+ *--------------------------------------------------------*/
+
+Gravity::Gravity(Board &board, Random &random)
+    : board{board},
+      random{random},
+      dry(static_cast<std::size_t>(board.size()), false)
+{ }
+
+/**
+ * Brings into the empty tile p the content that comes next
+ *
+ * The empty tiles above p are walked up to the first content. If
+ * it is movable, it falls straight down, if there is none a new
+ * candy comes from above the column. If it is a wall or icing, the
+ * content comes from beside it, through the tile below it, and is
+ * taken the same way when that neighbour is empty. The west
+ * neighbour is tried first.
+ *
+ * @param fall where the content comes from, the tiles it crosses
+ *  down to p are appended to its path
+ * @return false if nothing can come, the tiles walked are then
+ *  marked so that they are not walked again
+ */
+bool Gravity::supply(const Point &p, Fall &fall)
+{
+    Point top {p};
+    while (board.isIndexValid(top, Direction::North) && board.at(top, Direction::North).isEmpty())
+        top = top + directionModifier[static_cast<unsigned>(Direction::North)];
+
+    bool supplied {false};
+    Point from {top};
+    if (dry[static_cast<std::size_t>(tileIndex(top))]) {
+        // the tiles above were walked before and nothing came
+    } else if (!board.isIndexValid(top, Direction::North)) {
+        Tile t {};
+        t.type = ContentT::StandardCandy;
+        t.color = static_cast<CandyColor>(random.below(board.getColorRange()));
+        t.axis = Axis::Vertical;
+
+        fall.from = {p.x, board.rowCount()};
+        fall.isNew = true;
+        fall.tile = t;
+        board.at(top) = t;
+        supplied = true;
+
+    } else if (board.at(top, Direction::North).isMovable()) {
+        from = top + directionModifier[static_cast<unsigned>(Direction::North)];
+        fall.from = from;
+        supplied = true;
+
+    } else {
+        for (auto &d: {Direction::NorthWest, Direction::NorthEast}) {
+            if (!board.isIndexValid(top, d))
+                continue;
+            Point side {top + directionModifier[static_cast<unsigned>(d)]};
+            if (board.at(side).isMovable()) {
+                fall.from = side;
+            } else if (!board.at(side).isEmpty() || !supply(side, fall)) {
+                continue;
+            }
+            from = side;
+            supplied = true;
+            break;
+        }
+    }
+
+    for (int y = top.y; y>=p.y; --y) {
+        if (supplied)
+            fall.path.push_back({p.x, y});
+        else
+            dry[static_cast<std::size_t>(tileIndex({p.x, y}))] = true;
+    }
+    if (supplied && from != p)
+        board.at(p) = std::exchange(board.at(from), Tile{});
+    return supplied;
+}
+
+std::vector<Fall> Gravity::settle()
+{
+    std::vector<Fall> falls;
+    for (int i = 0; i<board.size(); ++i) {
+        Point p {board.pointOf(i)};
+        if (!board.at(p).isEmpty() || dry[static_cast<std::size_t>(i)])
+            continue;
+        Fall fall {};
+        if (supply(p, fall))
+            falls.push_back(std::move(fall));
+    }
+    return falls;
+}
@@ -0,0 +1,58 @@
+#ifndef GRAVITY_HPP
+#define GRAVITY_HPP
+
+#include <vector>
+
+#include "board.hpp"
+#include "point.hpp"
+#include "random.hpp"
+#include "tile.hpp"
+
+/**
+ * A content falling to where it comes to rest
+ */
+struct Fall
+{
+    Point from {0, 0};        // for a new candy, the tile above the top of its column
+    std::vector<Point> path;  // tiles crossed in order, the last one is where it lands
+    bool isNew {false};
+    Tile tile {};             // what a new candy is made of
+};
+
+/**
+ * Makes everything movable on a board fall, in one go
+ *
+ * The empty tiles are filled from the bottom row up, each one with
+ * the content that comes next into it (see supply): the first one
+ * above it in its column, a new candy when there is none, or one
+ * sliding from beside the wall or the icing that covers it. That
+ * content is moved once, from where it is to where it will stay.
+ *
+ * A tile that nothing can reach is walked once, so the cost is the
+ * size of the board plus the tiles crossed by the contents, which
+ * are given back as their paths anyway.
+ *
+ * @param board the board to settle, modified in place
+ * @param random colours of the new candies
+ */
+class Gravity
+{
+    private:
+        Board &board;
+        Random &random;
+        std::vector<bool> dry;  // per tile, whether nothing can come into it
+
+        int tileIndex(const Point &p) const { return p.y*board.colCount() + p.x; }
+
+        bool supply(const Point &p, Fall &fall);
+    public:
+        Gravity(Board &board, Random &random);
+
+        /**
+         * @return the contents that moved, the lowest landing tile first,
+         *  the board being left as it is when nothing can fall
+         */
+        std::vector<Fall> settle();
+};
+
+#endif // GRAVITY_HPP
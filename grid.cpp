@@ -1,6 +1,8 @@
 #include "grid.hpp"
 #include "game.hpp"
 
+#include <cstdlib>
+
 /*----------------------------------------------------------
  * Cell
  *--------------------------------------------------------*/
@@ -19,10 +21,54 @@ void Cell::draw()
 
 void Cell::drawContent()
 {
-    if (!isEmpty())
+    // Drawing can end an animation, and the state may then remove
+    // this very content (e.g. a colour bomb clearing the candy it
+    // was swapped with), it must live until its draw returns
+    if (isEmpty())
+        return;
+    if (content->tile().isStatic()) {
+        content->clearDamage();  // part of the backdrop
+        return;
+    }
+    std::shared_ptr<CellContent> drawn {content};
+    drawn->draw();
+}
+
+void Cell::drawBackground()
+{
+    if (drawable->getFillColor() == CELL_CLR)
+        clearDamage();  // same as in the backdrop
+    else
+        draw();
+}
+
+void Cell::paintBackdrop()
+{
+    Fl_Color current {drawable->getFillColor()};
+    drawable->setFillColor(CELL_CLR);
+    drawable->draw();
+    drawable->setFillColor(current);
+    if (!isEmpty() && content->tile().isStatic())
         content->draw();
 }
 
+/**
+ * Draws the cell and its content over what they were, without
+ * touching the rest of the grid
+ *
+ * Only right for contents that stay inside the cell.
+ */
+void Cell::repaint()
+{
+    const auto &bg {static_cast<const Rectangle&>(*drawable)};  // see constructor
+    Point topLeft {getCenter() - Point{bg.getWidth()/2, bg.getHeight()/2}};
+    fl_push_clip(topLeft.x, topLeft.y, bg.getWidth(), bg.getHeight());
+    grid.copyBackdrop(topLeft.x, topLeft.y, bg.getWidth(), bg.getHeight());
+    drawBackground();
+    drawContent();
+    fl_pop_clip();
+}
+
 void Cell::update(Event e)
 {
     switch (e) {
@@ -52,7 +98,7 @@ bool Cell::clear()
 {
     processedThisClearState = true;
     if (!isEmpty()) {
-        std::shared_ptr<ClearableCellContent> c{std::dynamic_pointer_cast<ClearableCellContent>(content)};
+        ClearableCellContent *c {content->asClearable()};
         if (c && !c->isClearing()) {
             c->clear();
             return true;
@@ -65,7 +111,7 @@ void Cell::clearWithoutAnimation()
 {
     processedThisClearState = true;
     if (!isEmpty()) {
-        std::shared_ptr<ClearableCellContent> c{std::dynamic_pointer_cast<ClearableCellContent>(content)};
+        ClearableCellContent *c {content->asClearable()};
         if (c && !c->isClearing()) {
             c->clearWithoutAnimation();
             removeContent();
@@ -73,9 +119,16 @@ void Cell::clearWithoutAnimation()
     }
 }
 
+void Cell::setContent(std::shared_ptr<CellContent> c)
+{
+    content = std::move(c);
+    grid.contentChanged(index);
+}
+
 void Cell::removeContent()
 {
     content.reset();
+    grid.contentChanged(index);
 }
 
 bool Cell::isEmpty() const
@@ -85,7 +138,7 @@ bool Cell::isEmpty() const
 
 bool Cell::isContentMovable() const
 {
-    return static_cast<bool>(std::dynamic_pointer_cast<MovableCellContent>(content));
+    return content && content->tile().isMovable();
 }
 
 bool Cell::moveContentTo(Cell &other)
@@ -93,10 +146,41 @@ bool Cell::moveContentTo(Cell &other)
     assert(!other.content);  // From game logic perspective
     other.removeContent();  // Warning: whatever was is other cell is destroyed
 
-    std::shared_ptr<MovableCellContent> c{std::dynamic_pointer_cast<MovableCellContent>(content)};
+    MovableCellContent *c {content ? content->asMovable() : nullptr};
     if (c) {
         c->moveTo(other.getIndex());
         other.content = std::move(content);
+        grid.contentChanged(index);
+        grid.contentChanged(other.index);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Removes the content without destroying it, so that
+ * it can be given to another cell
+ */
+std::shared_ptr<CellContent> Cell::takeContent()
+{
+    std::shared_ptr<CellContent> ret {std::move(content)};
+    content.reset();
+    grid.contentChanged(index);
+    return ret;
+}
+
+/**
+ * Gets a movable content coming from another cell, along
+ * the given cells, the last one being this cell
+ */
+bool Cell::receiveContent(std::shared_ptr<CellContent> c, const std::vector<Point> &path)
+{
+    assert(!content);  // From game logic perspective
+
+    MovableCellContent *m {c ? c->asMovable() : nullptr};
+    if (m) {
+        m->moveAlong(path);
+        setContent(std::move(c));
         return true;
     }
     return false;
@@ -110,8 +194,8 @@ bool Cell::swapContentWith(const Point &p)
     assert(getCenter() != other.getCenter());
     assert(content->getCenter() != other.content->getCenter());
 
-    std::shared_ptr<MovableCellContent> c{std::dynamic_pointer_cast<MovableCellContent>(content)};
-    std::shared_ptr<MovableCellContent> o{std::dynamic_pointer_cast<MovableCellContent>(other.content)};
+    MovableCellContent *c {content->asMovable()};
+    MovableCellContent *o {other.content->asMovable()};
     if (c && o) {
         // Add animations
         c->moveTo(other.getIndex());
@@ -128,13 +212,12 @@ bool Cell::swapContentWithWithoutAnimation(const Point &p)
 {
     Cell &otherCell {grid.at(p)};
 
-    std::shared_ptr<MovableCellContent> curr{std::dynamic_pointer_cast<MovableCellContent>(content)};
-    std::shared_ptr<MovableCellContent> other{std::dynamic_pointer_cast<MovableCellContent>(otherCell.getContent())};
-
-    if (curr && other) {
+    if (isContentMovable() && otherCell.isContentMovable()) {
         content->setCenter(otherCell.getCenter());
-        other->setCenter(getCenter());
+        otherCell.content->setCenter(getCenter());
         std::swap(content, otherCell.content);
+        grid.contentChanged(index);
+        grid.contentChanged(otherCell.index);
         return true;
     }
     return false;
@@ -143,8 +226,7 @@ bool Cell::swapContentWithWithoutAnimation(const Point &p)
 void Cell::contentWasSwappedWith(const Point &p)
 {
     assert(!isEmpty());
-    std::shared_ptr<MovableCellContent> movContent {std::dynamic_pointer_cast<MovableCellContent>(content)};
-    movContent->wasSwappedWith(p);
+    content->asMovable()->wasSwappedWith(p);
 }
 
 // GRID
@@ -152,14 +234,22 @@ void Cell::contentWasSwappedWith(const Point &p)
 bool Cell::toggleSelected()
 {
     selected = !selected;
-    drawable->setFillColor(selected ? CELL_SELECT_CLR : CELL_CLR);
+    setBackground(selected ? CELL_SELECT_CLR : CELL_CLR);
     return selected;
 }
 
+void Cell::setBackground(Fl_Color c)
+{
+    if (drawable->getFillColor() != c) {
+        drawable->setFillColor(c);
+        damage();
+    }
+}
+
 void Cell::mouseMove(Point mouseLoc)
 {
     if (!selected)
-        drawable->setFillColor(drawable->contains(mouseLoc) ? CELL_HOVER_CLR : CELL_CLR);
+        setBackground(drawable->contains(mouseLoc) ? CELL_HOVER_CLR : CELL_CLR);
 }
 
 void Cell::mouseClick(Point mouseLoc)
@@ -171,33 +261,29 @@ void Cell::mouseClick(Point mouseLoc)
 
 void Cell::mouseDrag(Point mouseLoc)
 {
-    if (grid.getSelectedCount() == 1 && drawable->contains(mouseLoc) && !isSelected())
-        for (auto &n: grid.neighboursOf(index))
-            if (grid.at(n).isSelected())
-                grid.select(index);
+    if (grid.getSelectedCount() == 1 && drawable->contains(mouseLoc) && !isSelected()
+            && grid.areNeighbours(grid.getSelected().at(0), index))
+        grid.select(index);
 }
 
 bool Cell::hasMatchWith(const Point &point)
 {
-    std::shared_ptr<MatchableCellContent> c{std::dynamic_pointer_cast<MatchableCellContent>(content)};
-    /* std::shared_ptr<MatchableCellContent> o{std::dynamic_pointer_cast<MatchableCellContent>(grid.at(point).getContent())}; */
-    return c && c->hasMatchWith(point);
+    const Cell &other {grid.at(point)};
+    return !isEmpty() && !other.isEmpty() && content->tile().matches(other.content->tile());
 }
 
 bool Cell::hint()
 {
     assert(!isEmpty() && !hasContentAnimation());
 
-    content->addAnimation(std::make_shared<PulseAnimation>(20));
+    content->addAnimation(grid.pool().make<PulseAnimation>(PULSE_TIME));
 
     return true;
 }
 
 bool Cell::hasSpecialCandy() const
 {
-    return content->getType() == ContentT::StripedCandy
-        || content->getType() == ContentT::WrappedCandy
-        || content->getType() == ContentT::ColourBomb;
+    return content->tile().isSpecial();
 }
 
 ContentT Cell::contentType() const
@@ -209,16 +295,22 @@ ContentT Cell::contentType() const
  *                      Grid
  *--------------------------------------------------------*/
 
-Grid::Grid(Point center, int width, int height, LevelData &data)
-    : Grid(center, width, height, data.getGridSize(), data.getGridSize(), data)
+Grid::Grid(Point center, int width, int height, LevelData &data, Random &random, ObjectPool &pool)
+    : Grid(center, width, height, data.getGridSize(), data.getGridSize(), data, random, pool)
 { }
 
-Grid::Grid(Point center, int width, int height, int rows, int columns, LevelData &data)
+Grid::Grid(Point center, int width, int height, int rows, int columns, LevelData &data, Random &random, ObjectPool &pool)
     : DrawableContainer(std::make_shared<Rectangle>(center, width, height, FL_BLACK)),
+    rows{rows},
+    columns{columns},
+    stride{columns+2},
     colSize{width/columns},
     rowSize{height/rows},
     state{nullptr},
-    candyColorRange{data.getColorRange()}
+    candyColorRange{data.getColorRange()},
+    m_random{random},
+    m_pool{pool},
+    m_model{rows, columns, data.getColorRange()}
 {
     // Down left corner
     Point z = center - Point{width/2, -height/2};
@@ -230,17 +322,15 @@ Grid::Grid(Point center, int width, int height, int rows, int columns, LevelData
     int w = colSize - space;
     int h = rowSize - space;
 
-    // Initialization of cell
-    for (int y = 0; y<rows; ++y) {
-        matrix.push_back({});
-            for (int x = 0; x<columns; ++x)
-                matrix[static_cast<unsigned>(y)].push_back(
-                        std::make_shared<Cell>(
-                            Point{z.x + (colSize*x + colSize/2), z.y - (rowSize*y + rowSize/2)},
-                            w, h, Point{x, y}, *this
-                            )
-                        );
-    }
+    // Initialization of cells, border included. Contents keep pointers
+    // to their cell so the storage must never be reallocated.
+    cells.reserve(static_cast<std::size_t>((rows+2)*stride));
+    for (int y = -1; y<=rows; ++y)
+        for (int x = -1; x<=columns; ++x)
+            cells.emplace_back(
+                    Point{z.x + (colSize*x + colSize/2), z.y - (rowSize*y + rowSize/2)},
+                    w, h, Point{x, y}, *this
+                    );
 
     cellContentSide = w>h ? h-20 : w-20; // TODO move to initialization list
 
@@ -250,33 +340,135 @@ Grid::Grid(Point center, int width, int height, int rows, int columns, LevelData
     /* setState(std::make_shared<EditState>(*this)); */
 }
 
+Grid::~Grid() noexcept
+{
+    if (m_backdrop)
+        fl_delete_offscreen(m_backdrop);
+}
+
+/**
+ * Draws the backdrop, then what differs from it: the cells that
+ * aren't at rest and the contents. Contents at rest are drawn in
+ * one batch, the animated ones after, over them.
+ */
 void Grid::draw() {
-    DrawableContainer::draw();
-    for (auto &c: *this) c.draw();
-    for (auto &c: *this) c.drawContent();
+    if (m_backdropStale)
+        paintBackdrop();
+    Point topLeft {origin()};
+    copyBackdrop(topLeft.x, topLeft.y, size().x, size().y);
+    clearDamage();
+
+    for (auto &c: *this) c.drawBackground();
+    {
+        RenderList::Batch batch {m_renderList};
+        for (auto &c: *this)
+            if (!c.hasContentAnimation())
+                c.drawContent();
+    }
+    for (auto &c: *this)
+        if (c.hasContentAnimation())
+            c.drawContent();
 }
 
-void Grid::mouseMove(Point mouseLoc)
+void Grid::paintBackdrop()
 {
+    if (!m_backdrop)
+        m_backdrop = fl_create_offscreen(size().x, size().y);
+
+    fl_begin_offscreen(m_backdrop);
+    fl_push_matrix();
+    fl_translate(-origin().x, -origin().y);
+    drawable->draw();
     for (auto &c: *this)
-        c.mouseMove(mouseLoc);
+        c.paintBackdrop();
+    fl_pop_matrix();
+    fl_end_offscreen();
+    m_backdropStale = false;
 }
 
-void Grid::mouseClick(Point mouseLoc)
+void Grid::copyBackdrop(int x, int y, int w, int h)
 {
+    fl_copy_offscreen(x, y, w, h, m_backdrop, x - origin().x, y - origin().y);
+}
+
+void Grid::drawDamaged()
+{
+    bool whole {isDamaged() || m_backdropStale};
+    for (auto &c: *this)
+        if (c.isContentMoving()) {
+            whole = true;
+            break;
+        }
+    if (whole) {
+        draw();
+        return;
+    }
+
     for (auto &c: *this)
-        c.mouseClick(mouseLoc);
+        if (c.needsRepaint())
+            c.repaint();
 }
 
-void Grid::mouseDrag(Point mouseLoc)
+bool Grid::isIdle()
 {
+    if (isDamaged())
+        return false;
     for (auto &c: *this)
-        c.mouseDrag(mouseLoc);
+        if (c.needsRepaint())
+            return false;
+    return true;
 }
 
+/**
+ * Cell whose background is under the given point, found from
+ * the layout of the grid instead of asking every cell
+ */
+std::optional<Point> Grid::cellAt(const Point &mouseLoc)
+{
+    Point bottomLeft {getCenter() + Point{-size().x/2, size().y/2}};
+    int dx {mouseLoc.x - bottomLeft.x};
+    int dy {bottomLeft.y - mouseLoc.y};  // rows are counted upwards
+    if (dx < 0 || dy < 0)
+        return std::nullopt;
+
+    Point p {dx/colSize, dy/rowSize};
+    if (!isIndexValid(p) || !at(p).contains(mouseLoc))
+        return std::nullopt;  // out of the grid, or between two cells
+    return p;
+}
+
+void Grid::mouseMove(Point mouseLoc)
+{
+    // Only the cells the pointer leaves or enters can change
+    std::optional<Point> hovered {cellAt(mouseLoc)};
+    if (m_hovered && m_hovered != hovered)
+        at(*m_hovered).mouseMove(mouseLoc);
+    if (hovered)
+        at(*hovered).mouseMove(mouseLoc);
+    m_hovered = hovered;
+}
+
+void Grid::mouseClick(Point mouseLoc)
+{
+    if (auto p {cellAt(mouseLoc)})
+        at(*p).mouseClick(mouseLoc);
+}
+
+void Grid::mouseDrag(Point mouseLoc)
+{
+    if (auto p {cellAt(mouseLoc)})
+        at(*p).mouseDrag(mouseLoc);
+}
+
+/**
+ * Cell at the given index
+ *
+ * No bounds check is done, one step outside of the grid
+ * lands on the empty border.
+ */
 Cell &Grid::at(const Point &p)
 {
-    return *matrix.at(static_cast<unsigned>(p.y)).at(static_cast<unsigned>(p.x));
+    return cells[storageIndex(p)];
 }
 
 Cell &Grid::at(const Point &p, Direction d)
@@ -286,53 +478,31 @@ Cell &Grid::at(const Point &p, Direction d)
 
 void Grid::select(const Point &p)
 {
-    at(p).toggleSelected() ? ++selectedCount : --selectedCount;
-    if (selectedCount == 2) { at(p).setLastSelected(true); }
+    if (at(p).toggleSelected())
+        selection.add(p);
+    else
+        selection.remove(p);
+    if (selection.size() == 2) { at(p).setLastSelected(true); }
     state->update(Event::SelectionChanged);
 }
 
-std::vector<Point> Grid::getSelected()
-{
-    std::vector<Point> ret;
-    for (auto &c : *this)
-        if (c.isSelected())
-            ret.push_back(c.getIndex());
-    return ret;
-}
-
+/**
+ * Only the selected cells are visited, not the whole grid
+ */
 void Grid::clearSelection()
 {
-    for (auto &c : *this)
-        if (c.isSelected()) {
-            c.toggleSelected();
-            --selectedCount;
-        }
-    assert(selectedCount == 0);
+    for (auto &p : selection)
+        at(p).toggleSelected();
+    selection.clear();
 }
 
 /**
  * Diagonal neighbours are not considered as neighbours
  */
-bool Grid::areNeighbours(const Point& p1, const Point& p2)
-{
-    for (auto &n: neighboursOf(p1))
-        if (n == p2)
-            return true;
-    return false;
-}
-
-// TODO make difference between accessible neighbours and
-// all neighbours
-std::vector<Point> Grid::neighboursOf(const Point& p)
+bool Grid::areNeighbours(const Point& p1, const Point& p2) const
 {
-    std::vector<Point> ret;
-    for (int i = 0; i<4; ++i) {
-        Point idx{p+directionModifier[static_cast<unsigned>(i)]};
-        if (isIndexValid(idx)) {
-            ret.push_back(idx);
-        }
-    }
-    return ret;
+    Point d {p1 - p2};
+    return isIndexValid(p1) && isIndexValid(p2) && std::abs(d.x) + std::abs(d.y) == 1;
 }
 
 void Grid::update(Event event)
@@ -348,7 +518,9 @@ void Grid::update(Event event)
 // TODO replace with update
 void Grid::cellContentAnimationFinished(const Point &p)
 {
-    state->gridAnimationFinished(p);
+    // The state often replaces itself from there
+    std::shared_ptr<State> current {state};
+    current->gridAnimationFinished(p);
 }
 
 // Clear the content of a vector of ptr to Cell
@@ -374,13 +546,13 @@ void Grid::put(const Point &point, ContentT content)
 
     switch (content) {
         case ContentT::StandardCandy:
-            toPut = std::make_shared<StandardCandy>(*this, &at(point), at(point).getCenter(), cellContentSide, static_cast<StandardCandy::Color>(std::rand()%getCandyColorRange()));
+            toPut = m_pool.make<StandardCandy>(*this, &at(point), at(point).getCenter(), cellContentSide, static_cast<StandardCandy::Color>(m_random.below(getCandyColorRange())));
             break;
         case ContentT::Wall:
-            toPut = std::make_shared<Wall>(*this, &at(point), at(point).getCenter(), cellContentSide);
+            toPut = m_pool.make<Wall>(*this, &at(point), at(point).getCenter(), cellContentSide);
             break;
         case ContentT::ColourBomb:
-            toPut = std::make_shared<ColourBomb>(*this, &at(point), at(point).getCenter(), cellContentSide);
+            toPut = m_pool.make<ColourBomb>(*this, &at(point), at(point).getCenter(), cellContentSide);
             break;
         default:
             break;
@@ -396,7 +568,7 @@ void Grid::put(const Point &point, ContentT content, int layer)
 
     switch (content) {
         case ContentT::Icing:
-            toPut = std::make_shared<Icing>(*this, &at(point), at(point).getCenter(), cellContentSide, layer);
+            toPut = m_pool.make<Icing>(*this, &at(point), at(point).getCenter(), cellContentSide, layer);
             break;
         default:
             break;
@@ -406,25 +578,30 @@ void Grid::put(const Point &point, ContentT content, int layer)
     at(point).setContent(toPut);
 }
 
+void Grid::put(const Point &point, ContentT content, StandardCandy::Color color)
+{
+    put(point, content, color, m_random.coin() ? Axis::Horizontal : Axis::Vertical);
+}
+
 void Grid::put(const Point &point, ContentT content, StandardCandy::Color color, Axis axis)
 {
     std::shared_ptr<CellContent> toPut;
 
     switch (content) {
         case ContentT::StandardCandy:
-            toPut = std::make_shared<StandardCandy>(*this, &at(point), at(point).getCenter(), cellContentSide, color);
+            toPut = m_pool.make<StandardCandy>(*this, &at(point), at(point).getCenter(), cellContentSide, color);
             break;
         case ContentT::StripedCandy:
-            toPut = std::make_shared<StripedCandy>(*this, &at(point), at(point).getCenter(), cellContentSide, color, axis);
+            toPut = m_pool.make<StripedCandy>(*this, &at(point), at(point).getCenter(), cellContentSide, color, axis);
             break;
         case ContentT::WrappedCandy:
-            toPut = std::make_shared<WrappedCandy>(*this, &at(point), at(point).getCenter(), cellContentSide, color);
+            toPut = m_pool.make<WrappedCandy>(*this, &at(point), at(point).getCenter(), cellContentSide, color);
             break;
         case ContentT::Wall:
-            toPut = std::make_shared<Wall>(*this, &at(point), at(point).getCenter(), cellContentSide);
+            toPut = m_pool.make<Wall>(*this, &at(point), at(point).getCenter(), cellContentSide);
             break;
         case ContentT::Icing:
-            toPut = std::make_shared<Icing>(*this, &at(point), at(point).getCenter(), cellContentSide);
+            toPut = m_pool.make<Icing>(*this, &at(point), at(point).getCenter(), cellContentSide);
             break;
         default:
             break;
@@ -434,6 +611,44 @@ void Grid::put(const Point &point, ContentT content, StandardCandy::Color color,
     at(point).setContent(toPut);
 }
 
+void Grid::put(const Point &point, const Tile &tile)
+{
+    switch (tile.type) {
+        case ContentT::Empty:
+            at(point).removeContent();
+            break;
+        case ContentT::StandardCandy:
+        case ContentT::StripedCandy:
+        case ContentT::WrappedCandy:
+            put(point, tile.type, tile.color, tile.axis);
+            break;
+        case ContentT::Icing:
+            put(point, tile.type, tile.layers);
+            break;
+        default:
+            put(point, tile.type);
+            break;
+    }
+}
+
+/**
+ * Puts back a snapshot, see snapshot()
+ *
+ * Only the cells whose content differs are rebuilt, without
+ * any animation. Nothing should be animated meanwhile.
+ */
+void Grid::restore(const Board &board)
+{
+    assert(board.rowCount() == rows && board.colCount() == columns);
+    assert(!animationPlaying());
+
+    for (auto &c: *this) {
+        Point p {c.getIndex()};
+        if (!m_model.at(p).sameContent(board.at(p)))
+            put(p, board.at(p));
+    }
+}
+
 bool Grid::isIndexValid(const Point &p, Direction d) const
 {
     return isIndexValid(p+directionModifier[static_cast<unsigned>(d)]);
@@ -441,20 +656,17 @@ bool Grid::isIndexValid(const Point &p, Direction d) const
 
 bool Grid::isIndexValid(const Point &p) const
 {
-    return p.x>=0 && static_cast<unsigned>(p.x)<colCount()
-        && p.y>=0 && static_cast<unsigned>(p.y)<rowCount();
+    return p.x>=0 && p.x<columns && p.y>=0 && p.y<rows;
 }
 
-bool Grid::swapCellContent(std::vector<Point> toSwap)
+bool Grid::swapCellContent(const Point &a, const Point &b)
 {
-    assert(toSwap.size() == 2);
-    return at(toSwap.at(0)).swapContentWith(toSwap.at(1));
+    return at(a).swapContentWith(b);
 }
 
-bool Grid::swapCellContentWithoutAnimation(std::vector<Point> toSwap)
+bool Grid::swapCellContentWithoutAnimation(const Point &a, const Point &b)
 {
-    assert(toSwap.size() == 2);
-    return at(toSwap.at(0)).swapContentWithWithoutAnimation(toSwap.at(1));
+    return at(a).swapContentWithWithoutAnimation(b);
 }
 
 bool Grid::hint(Point p)
@@ -468,6 +680,51 @@ void Grid::removeAnimations()
         c.removeContentAnimation();
 }
 
+/**
+ * Mirrors the content of a cell in the board model
+ * and in the bitboard
+ *
+ * Cells outside of the grid (e.g. the buffer used to make
+ * candies fall from above) are ignored.
+ */
+void Grid::mirror(const Point &p)
+{
+    Cell &c {at(p)};
+    Tile t {c.isEmpty() ? Tile{} : c.getContent()->tile()};
+    bool clearing {t.has(Tile::Clearing)};
+    t.flags = 0;  // other flags are only used by BoardEngine
+    if (clearing)
+        t.set(Tile::Clearing);
+    m_model.at(p) = t;
+    m_bits.refresh(p, t);
+}
+
+/**
+ * The content of a cell was put, moved or removed
+ */
+void Grid::contentChanged(const Point &p)
+{
+    at(p).damage();
+    if (!m_model.isIndexValid(p))
+        return;
+
+    bool wasStatic {m_model.at(p).isStatic()};
+    mirror(p);
+    m_changed.mark(p);
+    if (wasStatic || m_model.at(p).isStatic())
+        m_backdropStale = true;
+}
+
+/**
+ * The content of a cell started or stopped clearing
+ */
+void Grid::contentStateChanged(const Point &p)
+{
+    at(p).damage();
+    if (m_model.isIndexValid(p))
+        mirror(p);
+}
+
 // NOTE: passing by Point is probably better even if 
 // a little cumbersome, because this way methods will only
 // work on the matrix, they won't be callable by external actors
@@ -1,14 +1,24 @@
 #ifndef GRID_HPP
 #define GRID_HPP
 
+#include <FL/x.H>
 #include <cassert>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <vector>
 
+#include "bitboard.hpp"
+#include "board.hpp"
+#include "board_geometry.hpp"
+#include "dirty_set.hpp"
+#include "object_pool.hpp"
+#include "render_list.hpp"
+#include "selection.hpp"
 #include "shape.hpp"
 #include "colors.hpp"
 #include "point.hpp"
+#include "random.hpp"
 #include "cell_content.hpp"
 #include "common.hpp"
 #include "board_state.hpp"
@@ -35,6 +45,7 @@ class Cell : public DrawableContainer, public Interactive
         bool processedThisClearState{ false };
         bool lastSelected = false;
 
+        void setBackground(Fl_Color c);
     public:
         Cell(Point center, int width, int height, Point index, Grid &grid);
 
@@ -43,6 +54,17 @@ class Cell : public DrawableContainer, public Interactive
         void draw() override;
         void drawContent();
 
+        /// Background, if it doesn't look like the one of the backdrop
+        void drawBackground();
+
+        /// What the cell looks like at rest, that never changes
+        void paintBackdrop();
+
+        /// Whether the cell or its content changed since they were last drawn
+        bool needsRepaint() const { return isDamaged() || (content && content->isDamaged()); }
+        bool isContentMoving() const { return content && content->isMoving(); }
+        void repaint();
+
         void update(Event e);
 
         // Functions acting on the content of the cell
@@ -53,19 +75,20 @@ class Cell : public DrawableContainer, public Interactive
         bool isEmpty() const;
         bool isContentMovable() const;
         /* bool isClearing() { return content->isClearing(); } */
-        bool isContentClearing()
+        bool isContentClearing() const
         {
-            std::shared_ptr<ClearableCellContent> c{std::dynamic_pointer_cast<ClearableCellContent>(content)};
-            return c && c->isClearing();
+            return content && content->isClearing();
         }
 
         bool moveContentTo(Cell &other);
+        std::shared_ptr<CellContent> takeContent();
+        bool receiveContent(std::shared_ptr<CellContent> c, const std::vector<Point> &path);
         bool swapContentWith(const Point &p);
         void contentWasSwappedWith(const Point &p);
         bool swapContentWithWithoutAnimation(const Point &p);
 
         auto &getContent() { return content; }
-        void setContent(std::shared_ptr<CellContent> c) { content = std::move(c); }
+        void setContent(std::shared_ptr<CellContent> c);
 
         // actions on lastSelected
         bool isLastSelected() { return lastSelected; }
@@ -82,6 +105,8 @@ class Cell : public DrawableContainer, public Interactive
         void mouseClick(Point mouseLoc) override;
         void mouseDrag(Point mouseLoc) override;
 
+        bool contains(const Point &p) const { return drawable->contains(p); }
+
         bool hasContentAnimation() { return content ? content->hasAnimation() : false; }
 
         bool operator==(const Cell &other) { return index == other.index; }
@@ -101,22 +126,35 @@ class Cell : public DrawableContainer, public Interactive
         ContentT contentType() const;
 };
 
+/**
+ * The grid of the game, as seen on the screen
+ *
+ * The logical state of the grid is mirrored in a Board, kept in
+ * sync each time the content of a cell changes. The Grid is a view
+ * over it: it draws and animates, while the Board can be read or
+ * copied by anything that only needs the game logic.
+ */
 class Grid : public DrawableContainer, public Interactive
 {
-    public:
-        constexpr static std::array<Point, 8> directionModifier {
-            Point{ 0, -1},  // South
-            Point{ 0,  1},  // North
-            Point{-1,  0},  // West
-            Point{ 1,  0},  // East
-            Point{-1, -1},  // SouthWest
-            Point{ 1, -1},  // SouthEast
-            Point{-1,  1},  // NorthWest
-            Point{ 1,  1}   // NorthEast
-        };
     protected:
-        std::vector<std::vector<std::shared_ptr<Cell>>> matrix {};
-        int selectedCount = 0;
+        int rows;
+        int columns;
+
+        /**
+         * Cells stored by value, row by row, with a border
+         * of one empty cell all around the grid. Probes in any
+         * direction from a valid index never leave the storage.
+         */
+        std::vector<Cell> cells {};
+        int stride;  // columns+2, distance between two rows in cells
+
+        std::size_t storageIndex(const Point &p) const
+        {
+            assert(p.x>=-1 && p.x<=columns && p.y>=-1 && p.y<=rows);
+            return static_cast<std::size_t>((p.y+1)*stride + p.x+1);
+        }
+
+        Selection selection {};
 
         // Dimentions
         int cellContentSide = 10;
@@ -127,51 +165,105 @@ class Grid : public DrawableContainer, public Interactive
         std::shared_ptr<State> state;
 
         int candyColorRange;
-    public:
-        Grid(Point center, int width, int height, LevelData &data);
-        Grid(Point center, int width, int height, int rows, int columns, LevelData &data);
+        Random &m_random;  // owned by the level
+        ObjectPool &m_pool;  // owned by the level, makes the contents
+
+        Board m_model;
+        const BoardGeometry &m_geometry {BoardGeometry::of(rows, columns)};
+        DirtySet m_changed {rows, columns};  // cells changed since the last fall ended
 
+        MatchFinder m_matchFinder {MatchFinder::Walker};
+        BitBoard m_bits {rows, columns};  // kept in sync with m_model
+
+        /**
+         * Picture of what doesn't change in the grid: its background,
+         * the cells at rest and the walls. Frames start by copying it.
+         */
+        Fl_Offscreen m_backdrop {};
+        bool m_backdropStale {true};
+        RenderList m_renderList {};  // for the contents
+
+        std::optional<Point> m_hovered {};  // cell under the pointer
+
+        void mirror(const Point &p);
+        void paintBackdrop();
+
+        // Part of the window covered, the background being a Rectangle
+        Point size() const
+        {
+            const auto &bg {static_cast<const Rectangle&>(*drawable)};
+            return {bg.getWidth(), bg.getHeight()};
+        }
+        Point origin() const { return getCenter() - size()/2; }
+    public:
+        Grid(Point center, int width, int height, LevelData &data, Random &random, ObjectPool &pool);
+        Grid(Point center, int width, int height, int rows, int columns, LevelData &data, Random &random, ObjectPool &pool);
+        ~Grid() noexcept;
+
+        // Owns its backdrop
+        Grid(const Grid &) = delete;
+        Grid &operator=(const Grid &) = delete;
+
+        /**
+         * Walks the cells of the grid in storage order,
+         * jumping over the border.
+         */
         class Iterator {
             private:
                 Grid* g; //TODO make shared
-                Point coord;
+                std::size_t idx;
             public:
-                Iterator(Grid* g, Point coord) : g{g}, coord{coord} { }
+                Iterator(Grid* g, std::size_t idx) : g{g}, idx{idx} { }
 
                 Iterator &operator++() {
-                    int xs = static_cast<int>(g->matrix[0].size());
-                    ++coord.x;
-                    coord.y += coord.x/xs;
-                    coord.x %= xs;
+                    ++idx;
+                    if (idx%static_cast<std::size_t>(g->stride) == static_cast<std::size_t>(g->stride-1))
+                        idx += 2;  // right border of this row and left border of the next one
                     return *this;
                 }
-                Cell &operator*() { return g->at(coord); }
-                bool operator!=(const Iterator &other) { return coord != other.coord; }
+                Cell &operator*() { return g->cells[idx]; }
+                bool operator!=(const Iterator &other) { return idx != other.idx; }
         };
 
-        Iterator begin() { return Iterator{this, {0, 0}}; }
-        Iterator end() { return Iterator{this, {0, static_cast<int>(matrix.size())}}; }
+        Iterator begin() { return Iterator{this, storageIndex({0, 0})}; }
+        Iterator end() { return Iterator{this, storageIndex({0, rows})}; }
 
         Cell &at(const Point &p);
         Cell &at(const Point &c, Direction d);
 
         void select(const Point &c);
-        int getSelectedCount() const { return selectedCount; }
-        std::vector<Point> getSelected();
+        int getSelectedCount() const { return static_cast<int>(selection.size()); }
+        const Selection &getSelected() const { return selection; }
         void clearSelection();
 
         // Here diagonal neighbours are not considered as neighbours
-        bool areNeighbours(const Point& c1, const Point& c2);
-        std::vector<Point> neighboursOf(const Point& c);
+        bool areNeighbours(const Point& c1, const Point& c2) const;
+        BoardGeometry::Span neighboursOf(const Point& c) const { return m_geometry.neighboursOf(c); }
+
+        /// Neighbours, lines and squares of the cells, see BoardGeometry
+        const BoardGeometry &geometry() const { return m_geometry; }
 
         void draw() override;
 
+        /// Copies part of the backdrop, in the coordinates of the window
+        void copyBackdrop(int x, int y, int w, int h);
+
+        /**
+         * Draws only the cells that changed since the last frame,
+         * or the whole grid if a content is moving across cells
+         */
+        void drawDamaged();
+
+        /// Whether drawing would change nothing on the screen
+        bool isIdle();
+
         void setState(std::shared_ptr<State> newState)
         {
             state = newState;
         }
 
-        // Mouse interactions
+        // Mouse interactions, only the cell under the pointer is concerned
+        std::optional<Point> cellAt(const Point &mouseLoc);
         void mouseMove(Point mouseLoc) override;
         void mouseClick(Point mouseLoc) override;
         void mouseDrag(Point mouseLoc) override;
@@ -186,7 +278,9 @@ class Grid : public DrawableContainer, public Interactive
         // For different contents
         void put(const Point &point, ContentT content);  // All no parameter contents
         void put(const Point &point, ContentT content, int layer);  // Icing
-        void put(const Point &point, ContentT content, StandardCandy::Color color, Axis axis = std::rand()%2 ? Axis::Horizontal : Axis::Vertical); // Candies
+        void put(const Point &point, ContentT content, StandardCandy::Color color);  // Candies, random axis
+        void put(const Point &point, ContentT content, StandardCandy::Color color, Axis axis); // Candies
+        void put(const Point &point, const Tile &tile);  // Whatever the tile describes
 
         bool animationPlaying()
         {
@@ -196,14 +290,14 @@ class Grid : public DrawableContainer, public Interactive
             return false;
         }
 
-        unsigned colCount() const { return static_cast<unsigned>(matrix.at(0).size()); }
-        unsigned rowCount() const { return static_cast<unsigned>(matrix.size()); }
+        unsigned colCount() const { return static_cast<unsigned>(columns); }
+        unsigned rowCount() const { return static_cast<unsigned>(rows); }
 
         bool isIndexValid(const Point &p, Direction d) const;
         bool isIndexValid(const Point &p) const;
 
-        bool swapCellContent(std::vector<Point> toSwap);
-        bool swapCellContentWithoutAnimation(std::vector<Point> toSwap);
+        bool swapCellContent(const Point &a, const Point &b);
+        bool swapCellContentWithoutAnimation(const Point &a, const Point &b);
 
         void update(Event e);
         void cellContentAnimationFinished(const Point &p);
@@ -215,9 +309,34 @@ class Grid : public DrawableContainer, public Interactive
         bool hasCellMatchWith(const Point &a, const Point &b) { return at(a).hasMatchWith(b); }
 
         int getCandyColorRange() const { return candyColorRange; }
+        Random &random() { return m_random; }
+
+        /// Where contents, their shapes and animations are made
+        ObjectPool &pool() { return m_pool; }
 
         bool hint(Point p);
         void removeAnimations();
+
+        // Board model
+        const Board &model() const { return m_model; }
+
+        /**
+         * Copy of the logical state of the grid, a plain value that
+         * can be played on (see BoardEngine, or the Board versions of
+         * the MatchState rules) without touching any content
+         */
+        Board snapshot() const { return m_model; }
+        void restore(const Board &board);
+        void contentChanged(const Point &p);
+        void contentStateChanged(const Point &p);
+
+        /// Cells whose content changed since the last call
+        std::vector<Point> takeChangedCells() { return m_changed.take(); }
+        void clearChangedCells() { m_changed.clear(); }
+
+        void setMatchFinder(MatchFinder f) { m_matchFinder = f; }
+        MatchFinder getMatchFinder() const { return m_matchFinder; }
+        const BitBoard &bitboard() const { return m_bits; }
 };
 
 #endif
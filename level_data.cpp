@@ -1,5 +1,6 @@
 #include "level_data.hpp"
 
+#include "board.hpp"
 #include "point.hpp"
 #include "event.hpp"
 #include "level_goal.hpp"
@@ -28,10 +29,20 @@ void LevelData::extractDataFrom(std::string filename)
     if (m_goalType == "")
         throw std::runtime_error{"Goal cannot be empty"};  // for now
 
+    m_goal = makeGoal();
+}
+
+/**
+ * A new goal, in its initial state, for one more
+ * game of the level
+ */
+std::shared_ptr<LevelGoal> LevelData::makeGoal() const
+{
     if (m_goalType == "Icing") {
         auto icingCount {2*getDoubleIcingPos().size() + getSingleIncingPos().size()};
-        m_goal = std::make_shared<EventOccurGoal>(m_movesToGoal, Event::IcingCleared, icingCount);
+        return std::make_shared<EventOccurGoal>(m_movesToGoal, Event::IcingCleared, icingCount);
     }
+    return nullptr;
 }
 
 void LevelData::processLine(std::string line)
@@ -44,7 +55,7 @@ void LevelData::processLine(std::string line)
 
     if (category == "Size") {
         is >> m_gridSize;
-        if (!is || m_gridSize<3 || m_gridSize>26)
+        if (!is || m_gridSize<3 || m_gridSize>Board::maxSide)
             throw std::runtime_error{"LevelData: Wrong size given"};
 
     } else if (category == "ColorRange") {
@@ -51,6 +51,7 @@ class LevelData
 
         int movesToGoal() const { return m_movesToGoal; }
         auto goal() { return m_goal; }
+        std::shared_ptr<LevelGoal> makeGoal() const;
 
         int getGridSize() const { return m_gridSize; }
         int getColorRange() const { return m_colorRange; }
@@ -27,6 +27,7 @@ void LevelStatus::updateScore(int toAdd)
 {
     m_score += toAdd;
     m_scoreDrawable.setString(std::to_string(m_score));
+    damage();
 }
 
 void LevelStatus::update(Event event)
@@ -41,6 +42,7 @@ void LevelStatus::update(Event event)
     case Event::GoalChanged:
         m_movesLeftDrawable.setString(std::to_string(m_goal->movesLeft()));
         m_goalDrawable.setString(m_goal->progressToString());
+        damage();
         break;
     default:
         m_goal->update(event);
@@ -11,10 +11,16 @@
 #include <FL/fl_draw.H>
 #include <FL/Fl_Double_Window.H>
 
-#include <time.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
 
 /* #include "grid.hpp" */
+#include "frame_clock.hpp"
 #include "game.hpp"
+#include "sprite_cache.hpp"
 
 const int windowWidth = 500;
 const int windowHeight = 600;
@@ -24,37 +30,86 @@ const int refreshPerSecond = 60;
  * MainWindow class
  *------------------------------------------------*/
 
+/**
+ * Window of the game
+ *
+ * Frames are only drawn when needed: 60 times per second while the
+ * game isn't idle (e.g. during animations), otherwise at its next
+ * deadline or after the next input, whichever comes first. Only the
+ * damaged parts of the game are drawn again (FL_DAMAGE_USER1),
+ * unless the window was exposed.
+ */
 class MainWindow : public Fl_Window
 {
 private:
         /* Grid game; */
         Game game;
+        bool framePending {false};  // the timer is set for the next frame
+
+        /**
+         * Sets the timer for when the next frame is needed, to be
+         * called after anything that may have changed the game
+         */
+        void schedule()
+        {
+            if (!game.isIdle()) {
+                if (!framePending) {
+                    Fl::remove_timeout(Timer_CB, this);
+                    Fl::add_timeout(1.0/refreshPerSecond, Timer_CB, this);
+                    framePending = true;
+                }
+                return;
+            }
+
+            Fl::remove_timeout(Timer_CB, this);
+            framePending = false;
+            FrameClock::resume();  // the time spent idle isn't to be caught up on
+            if (auto deadline {game.nextDeadline()}) {
+                std::chrono::duration<double> wait {*deadline - FrameClock::Clock::now()};
+                Fl::add_timeout(std::max(0.0, wait.count()), Timer_CB, this);
+            }
+        }
 public:
-    MainWindow()
+    MainWindow(std::uint64_t seed)
         : Fl_Window(500, 500, windowWidth, windowHeight, "Candy Crush"),
-        game{*this}
+        game{*this, seed}
     {
-        Fl::add_timeout(1.0/refreshPerSecond, Timer_CB, this);
+        schedule();
         resizable(this);
     }
 
     void draw() override
     {
-        Fl_Window::draw();
-        game.draw();
+        FrameClock::tick();
+        if (damage() & ~FL_DAMAGE_USER1) {  // exposed, resized...
+            Fl_Window::draw();
+            game.draw();
+        } else
+            game.drawDamaged();
+        schedule();
+    }
+
+    void resize(int x, int y, int w, int h) override
+    {
+        Fl_Window::resize(x, y, w, h);
+        SpriteCache::clear();  // made for the previous size
     }
 
     int handle(int event) override
     {
+        FrameClock::sync();  // the game may have been idle since the last frame
         switch (event) {
         case FL_MOVE:
             game.mouseMove(Point{Fl::event_x(), Fl::event_y()});
+            schedule();
             return 1;
         case FL_PUSH:
             game.mouseClick(Point{Fl::event_x(), Fl::event_y()});
+            schedule();
             return 1;
         case FL_DRAG:
             game.mouseDrag(Point{Fl::event_x(), Fl::event_y()});
+            schedule();
             return 1;
         /* case FL_KEYDOWN: */
         /*     game.keyPressed(Fl::event_key()); */
@@ -66,8 +121,8 @@ public:
     static void Timer_CB(void *userdata)
     {
         MainWindow *o = static_cast<MainWindow*>(userdata);
-        o->redraw();
-        Fl::repeat_timeout(1.0/refreshPerSecond, Timer_CB, userdata);
+        o->framePending = false;
+        o->damage(FL_DAMAGE_USER1);  // the next one is scheduled once drawn
     }
 };
 
@@ -76,10 +131,20 @@ public:
  * Main
  *------------------------------------------------*/
 
+/**
+ * The game can be replayed by giving the seed of a previous
+ * session in the CANDY_SEED environment variable, the seed
+ * used is printed at start.
+ */
 int main(int argc, char *argv[])
 {
-    srand(static_cast<unsigned>(time(nullptr)));
-    MainWindow window;
+    std::uint64_t seed {static_cast<std::uint64_t>(
+            std::chrono::system_clock::now().time_since_epoch().count())};
+    if (const char *s = std::getenv("CANDY_SEED"))
+        seed = std::strtoull(s, nullptr, 10);
+    std::cout << "Seed: " << seed << std::endl;
+
+    MainWindow window{seed};
     window.show(argc, argv);
     return Fl::run();
 }
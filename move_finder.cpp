@@ -0,0 +1,235 @@
+#include "move_finder.hpp"
+
+#include <bit>
+
+namespace {
+
+std::uint32_t bit(int i)
+{
+    return std::uint32_t{1} << i;
+}
+
+/**
+ * The masks of a BitBoard as they would be after swapping
+ * the candies at a and b
+ */
+class SwapView
+{
+    private:
+        const BitBoard &bits;
+        Point a;
+        Point b;
+        int colorA;  // before the swap
+        int colorB;
+    public:
+        SwapView(const BitBoard &bits, const Point &a, const Point &b)
+            : bits{bits}, a{a}, b{b}, colorA{bits.colorAt(a)}, colorB{bits.colorAt(b)}
+        { }
+
+        std::uint32_t row(int c, int y) const
+        {
+            std::uint32_t m {bits.rowMask(c, y)};
+            if (a.y == y)
+                m = (m & ~bit(a.x)) | (colorB == c ? bit(a.x) : 0);
+            if (b.y == y)
+                m = (m & ~bit(b.x)) | (colorA == c ? bit(b.x) : 0);
+            return m;
+        }
+
+        std::uint32_t col(int c, int x) const
+        {
+            std::uint32_t m {bits.colMask(c, x)};
+            if (a.x == x)
+                m = (m & ~bit(a.y)) | (colorB == c ? bit(a.y) : 0);
+            if (b.x == x)
+                m = (m & ~bit(b.y)) | (colorA == c ? bit(b.y) : 0);
+            return m;
+        }
+
+        // Length of the runs of color c going through p, p included
+        int horizontal(int c, const Point &p) const
+        {
+            std::uint32_t r {row(c, p.y)};
+            return std::countr_one(r >> p.x) + std::countl_one(r << (BitBoard::maxSide-1 - p.x)) - 1;
+        }
+
+        int vertical(int c, const Point &p) const
+        {
+            std::uint32_t r {col(c, p.x)};
+            return std::countr_one(r >> p.y) + std::countl_one(r << (BitBoard::maxSide-1 - p.y)) - 1;
+        }
+
+        /// See Combination::getTotalCount
+        std::size_t total(int c, const Point &p) const
+        {
+            int h {horizontal(c, p)};
+            int v {vertical(c, p)};
+            return static_cast<std::size_t>((h>2 ? h : 0) + (v>2 ? v : 0));
+        }
+
+        /**
+         * Total of the best combination containing p, like
+         * getCombinationContaining with rec: the elements are
+         * tried in the order of Combination::getAllElements.
+         *
+         * @param origin set to the origin of that combination
+         */
+        std::size_t bestTotal(int c, const Point &p, Point &origin) const
+        {
+            std::size_t ret {total(c, p)};
+            origin = p;
+
+            std::uint32_t r {row(c, p.y)};
+            std::uint32_t k {col(c, p.x)};
+            int east {std::countr_one(r >> p.x) - 1};
+            int west {std::countl_one(r << (BitBoard::maxSide-1 - p.x)) - 1};
+            int north {std::countr_one(k >> p.y) - 1};
+            int south {std::countl_one(k << (BitBoard::maxSide-1 - p.y)) - 1};
+
+            auto tryElem = [&](const Point &e) {
+                std::size_t t {total(c, e)};
+                if (t > ret) {
+                    ret = t;
+                    origin = e;
+                }
+            };
+            for (int i = 1; i<=north; ++i) tryElem({p.x, p.y+i});
+            for (int i = 1; i<=south; ++i) tryElem({p.x, p.y-i});
+            for (int i = 1; i<=east; ++i) tryElem({p.x+i, p.y});
+            for (int i = 1; i<=west; ++i) tryElem({p.x-i, p.y});
+
+            return ret;
+        }
+};
+
+/**
+ * Cells where a candy of the color of r (a row or a column)
+ * completes a line of 3, given where it can come from
+ *
+ * Bit x of r>>1 is bit x+1 of r, so the "two of three" templates
+ * are ..XX (filled from before), XX.. (filled from after) and X.X,
+ * the candy coming from the previous or next line in every case.
+ */
+std::uint32_t lineTargets(std::uint32_t r, std::uint32_t before, std::uint32_t after)
+{
+    std::uint32_t side {before | after};
+    std::uint32_t nextTwo {r>>1 & r>>2};
+    std::uint32_t prevTwo {r<<1 & r<<2};
+    std::uint32_t around {r<<1 & r>>1};
+    return (nextTwo & (r<<1 | side))
+        | (prevTwo & (r>>1 | side))
+        | (around & side);
+}
+
+}  // namespace
+
+/*----------------------------------------------------------
+ * MoveFinder
+ *--------------------------------------------------------*/
+
+/**
+ * What moving the candy at from to its neighbour to gives,
+ * for the candy arriving at to only.
+ */
+Swap MoveFinder::evaluate(const Point &from, const Point &to) const
+{
+    Swap ret {from, to, 0};
+    int c {bits.colorAt(from)};
+    if (c == -1 || bits.colorAt(to) == -1)
+        return ret;
+
+    SwapView view {bits, from, to};
+    Point origin {to};
+    ret.total = view.bestTotal(c, to, origin);
+    return ret;
+}
+
+/**
+ * Best swap of the board, the first one found in case of equality,
+ * cells being visited like the Grid iterator does.
+ */
+Swap MoveFinder::best() const
+{
+    Swap ret {};
+    for (int y = 0; y<bits.rowCount(); ++y) {
+        for (int x = 0; x<bits.colCount(); ++x) {
+            Point p {x, y};
+            for (auto &d: {Direction::North, Direction::East}) {
+                Point n {p + directionModifier[static_cast<unsigned>(d)]};
+                if (n.x >= bits.colCount() || n.y >= bits.rowCount())
+                    continue;
+
+                for (auto &s: {evaluate(n, p), evaluate(p, n)})
+                    if (s.total > ret.total)
+                        ret = s;
+            }
+        }
+    }
+    return ret;
+}
+
+/**
+ * Whether a swap giving a combination exists
+ *
+ * Cheaper than best(), every line is matched against the
+ * templates of a line of 3 missing one candy, for each color.
+ */
+bool MoveFinder::hasMove() const
+{
+    for (int y = 0; y<bits.rowCount(); ++y) {
+        std::uint32_t candies {0};
+        for (int c = 0; c<BitBoard::colorCount; ++c)
+            candies |= bits.rowMask(c, y);
+
+        for (int c = 0; c<BitBoard::colorCount; ++c) {
+            std::uint32_t r {bits.rowMask(c, y)};
+            if (lineTargets(r, bits.rowMask(c, y-1), bits.rowMask(c, y+1)) & candies & ~r)
+                return true;
+        }
+    }
+
+    for (int x = 0; x<bits.colCount(); ++x) {
+        std::uint32_t candies {0};
+        for (int c = 0; c<BitBoard::colorCount; ++c)
+            candies |= bits.colMask(c, x);
+
+        for (int c = 0; c<BitBoard::colorCount; ++c) {
+            std::uint32_t k {bits.colMask(c, x)};
+            if (lineTargets(k, bits.colMask(c, x-1), bits.colMask(c, x+1)) & candies & ~k)
+                return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * The combination the swap gives, the one getCombinationContaining
+ * would return once the swap is done.
+ */
+Combination MoveFinder::combinationOf(const Swap &s) const
+{
+    int c {bits.colorAt(s.from)};
+    SwapView view {bits, s.from, s.to};
+    Point origin {s.to};
+    view.bestTotal(c, s.to, origin);
+
+    Combination ret {origin};
+    std::uint32_t r {view.row(c, origin.y)};
+    std::uint32_t k {view.col(c, origin.x)};
+    int east {std::countr_one(r >> origin.x) - 1};
+    int north {std::countr_one(k >> origin.y) - 1};
+    int west {std::countl_one(r << (BitBoard::maxSide-1 - origin.x)) - 1};
+    int south {std::countl_one(k << (BitBoard::maxSide-1 - origin.y)) - 1};
+
+    // Same order as the walker
+    for (int i = 1; i<=east; ++i)
+        ret.addHorizontalElement({origin.x+i, origin.y});
+    for (int i = 1; i<=north; ++i)
+        ret.addVerticalElement({origin.x, origin.y+i});
+    for (int i = 1; i<=west; ++i)
+        ret.addHorizontalElement({origin.x-i, origin.y});
+    for (int i = 1; i<=south; ++i)
+        ret.addVerticalElement({origin.x, origin.y-i});
+
+    return ret;
+}
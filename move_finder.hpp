@@ -0,0 +1,51 @@
+#ifndef MOVE_FINDER_HPP
+#define MOVE_FINDER_HPP
+
+#include <cstddef>
+
+#include "bitboard.hpp"
+#include "combination.hpp"
+#include "point.hpp"
+
+/**
+ * A candy moved by the player and what it gives
+ */
+struct Swap
+{
+    Point from {0, 0};  // cell of the candy that moves
+    Point to {0, 0};    // where it goes, the combination is around it
+    std::size_t total {0};  // see Combination::getTotalCount, 0 if no combination
+
+    bool isValid() const { return total > 0; }
+};
+
+/**
+ * Looks for the swaps of two candies that give a combination
+ *
+ * Swaps are never played: the masks of the BitBoard are read as if
+ * the two candies were exchanged, so the board is left untouched and
+ * nothing is allocated while searching.
+ *
+ * Only swaps of two candies are considered, the colour bomb and
+ * the special candies being handled apart (see
+ * ReadyState::getBestSpecialCombination).
+ *
+ * @param bits the candies of the board
+ */
+class MoveFinder
+{
+    private:
+        const BitBoard &bits;
+    public:
+        explicit MoveFinder(const BitBoard &bits) noexcept
+            : bits{bits}
+        { }
+
+        Swap evaluate(const Point &from, const Point &to) const;
+        Swap best() const;
+        bool hasMove() const;
+
+        Combination combinationOf(const Swap &s) const;
+};
+
+#endif // MOVE_FINDER_HPP
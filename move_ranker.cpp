@@ -0,0 +1,49 @@
+#include "move_ranker.hpp"
+
+#include <algorithm>
+#include <future>
+
+#include "board_engine.hpp"
+
+/*----------------------------------------------------------
+ * MoveRanker
+ *--------------------------------------------------------*/
+
+std::vector<RankedMove> MoveRanker::rank(const Board &board) const
+{
+    // Candidate swaps, both contents must be movable
+    std::vector<RankedMove> candidates;
+    for (int i = 0; i<board.size(); ++i) {
+        Point p {board.pointOf(i)};
+        for (auto &d: {Direction::North, Direction::East}) {
+            if (board.isIndexValid(p, d)
+                    && board.at(p).isMovable()
+                    && board.at(p, d).isMovable())
+                candidates.push_back({p, p + directionModifier[static_cast<unsigned>(d)]});
+        }
+    }
+
+    std::vector<std::future<bool>> played;
+    played.reserve(candidates.size());
+    for (auto &m: candidates) {
+        played.push_back(pool.submit([&board, &m, s = seed]() {
+                    Board copy {board};
+                    BoardEngine engine {copy, s};
+                    if (!engine.playMove(m.a, m.b))
+                        return false;
+                    m.score = engine.score();
+                    m.cascades = engine.cascades();
+                    return true;
+                    }));
+    }
+
+    std::vector<RankedMove> ret;
+    for (std::size_t i = 0; i<candidates.size(); ++i)
+        if (played[i].get())
+            ret.push_back(candidates[i]);
+
+    std::stable_sort(ret.begin(), ret.end(), [](const RankedMove &l, const RankedMove &r) {
+            return l.score > r.score || (l.score == r.score && l.cascades > r.cascades);
+            });
+    return ret;
+}
@@ -0,0 +1,53 @@
+#ifndef MOVE_RANKER_HPP
+#define MOVE_RANKER_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "board.hpp"
+#include "point.hpp"
+#include "thread_pool.hpp"
+
+/**
+ * A legal swap and what playing it gave on a copy of the board
+ */
+struct RankedMove
+{
+    Point a {0, 0};
+    Point b {0, 0};  // the cell selected last
+    int score {0};     // points earned by the whole turn
+    int cascades {0};  // clear and fall rounds of the turn
+};
+
+/**
+ * Scores every legal swap of a board
+ *
+ * Each swap is played as a whole turn, cascades included, by a
+ * BoardEngine on its own copy of the board. The turns are spread
+ * over the threads of the pool.
+ *
+ * Every copy draws its new candies from the same seed, so the
+ * moves are compared on the same refills and the ranking is the
+ * same from one run to the other.
+ *
+ * @param pool the threads to play the swaps on
+ * @param seed seed of the engines
+ */
+class MoveRanker
+{
+    private:
+        ThreadPool &pool;
+        std::uint64_t seed;
+    public:
+        MoveRanker(ThreadPool &pool, std::uint64_t seed = 1) noexcept
+            : pool{pool}, seed{seed}
+        { }
+
+        /**
+         * @return the legal swaps, best score first, ties broken by
+         *  cascades then by the order of the cells
+         */
+        std::vector<RankedMove> rank(const Board &board) const;
+};
+
+#endif // MOVE_RANKER_HPP
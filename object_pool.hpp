@@ -0,0 +1,42 @@
+#ifndef OBJECT_POOL_HPP
+#define OBJECT_POOL_HPP
+
+#include <memory>
+#include <memory_resource>
+#include <utility>
+
+/**
+ * Memory of the objects a level makes by the hundreds
+ *
+ * Contents, their shapes and their animations are made at every
+ * fall and clear. Here they are taken from free lists, one per
+ * size, refilled a chunk at a time: once the first cascades are
+ * over, making one no longer asks the system for memory. What an
+ * object gives back when its last owner goes is kept for the next
+ * one of the same size.
+ *
+ * All the memory is released at once when the pool is destroyed,
+ * objects made from it must not outlive it. Not thread-safe.
+ */
+class ObjectPool
+{
+    private:
+        std::pmr::unsynchronized_pool_resource m_resource {};
+    public:
+        ObjectPool() = default;
+
+        ObjectPool(const ObjectPool &) = delete;
+        ObjectPool &operator=(const ObjectPool &) = delete;
+
+        /// Same as std::make_shared, object and count in one block of the pool
+        template<class T, class... Args>
+        std::shared_ptr<T> make(Args&&... args)
+        {
+            return std::allocate_shared<T>(
+                    std::pmr::polymorphic_allocator<T>{&m_resource},
+                    std::forward<Args>(args)...
+                    );
+        }
+};
+
+#endif // OBJECT_POOL_HPP
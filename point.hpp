@@ -1,6 +1,7 @@
 #ifndef POINT_HPP
 #define POINT_HPP
 
+#include <array>
 #include <iostream>
 
 /**
@@ -20,6 +21,32 @@ struct Point
     bool operator==(const Point& other) const;
 };
 
+enum class Direction {
+    South,
+    North,
+    West,
+    East,
+    SouthWest,
+    SouthEast,
+    NorthWest,
+    NorthEast
+};
+
+/**
+ * Offset to apply to a point to reach its neighbour
+ * in the given direction, indexed by Direction
+ */
+constexpr std::array<Point, 8> directionModifier {
+    Point{ 0, -1},  // South
+    Point{ 0,  1},  // North
+    Point{-1,  0},  // West
+    Point{ 1,  0},  // East
+    Point{-1, -1},  // SouthWest
+    Point{ 1, -1},  // SouthEast
+    Point{-1,  1},  // NorthWest
+    Point{ 1,  1}   // NorthEast
+};
+
 std::ostream &operator<<(std::ostream &ost, const Point &p);
 std::istream &operator>>(std::istream &ist, Point &p);
 
@@ -0,0 +1,23 @@
+#include "random.hpp"
+
+/*----------------------------------------------------------
+ * Random
+ *--------------------------------------------------------*/
+
+/**
+ * Spreads the seed over the whole state with splitmix64,
+ * as advised by the authors of xoshiro: close seeds give
+ * unrelated sequences and the state is never all zeros.
+ */
+void Random::seed(std::uint64_t seed)
+{
+    for (std::size_t i = 0; i<state.size(); i += 2) {
+        seed += 0x9e3779b97f4a7c15;
+        std::uint64_t z {seed};
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        z ^= z >> 31;
+        state[i] = static_cast<std::uint32_t>(z);
+        state[i+1] = static_cast<std::uint32_t>(z >> 32);
+    }
+}
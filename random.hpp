@@ -0,0 +1,62 @@
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+/**
+ * Seedable random generator (xoshiro128**)
+ *
+ * Replaces std::rand, which hides a global state: every level (and
+ * every BoardEngine) owns its generator, so a game can be replayed
+ * from its seed and several games can be simulated at once.
+ *
+ * Satisfies UniformRandomBitGenerator, so it can also be given to
+ * the distributions and algorithms of <random>.
+ *
+ * @param seed any value, even 0, is a valid seed
+ */
+class Random
+{
+    private:
+        std::array<std::uint32_t, 4> state {};
+    public:
+        using result_type = std::uint32_t;
+
+        explicit Random(std::uint64_t seed = 1) { this->seed(seed); }
+
+        void seed(std::uint64_t seed);
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return UINT32_MAX; }
+
+        result_type operator()()
+        {
+            const std::uint32_t ret {std::rotl(state[1]*5, 7)*9};
+            const std::uint32_t t {state[1] << 9};
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= t;
+            state[3] = std::rotl(state[3], 11);
+            return ret;
+        }
+
+        /// Number in [0, n), n must be positive
+        int below(int n)
+        {
+            return static_cast<int>((std::uint64_t{(*this)()} * static_cast<std::uint64_t>(n)) >> 32);
+        }
+
+        bool coin() { return (*this)() >> 31; }
+
+        /// Seed for another generator, e.g. the one of a new level
+        std::uint64_t nextSeed()
+        {
+            return std::uint64_t{(*this)()} << 32 | (*this)();
+        }
+};
+
+#endif // RANDOM_HPP
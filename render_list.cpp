@@ -0,0 +1,76 @@
+#include "render_list.hpp"
+
+#include <FL/fl_draw.H>
+#include <algorithm>
+#include <cmath>
+
+#include "animation.hpp"
+
+/*----------------------------------------------------------
+ * RenderList
+ *--------------------------------------------------------*/
+
+namespace {
+
+int screenX(int x, int y) { return static_cast<int>(std::lround(fl_transform_x(x, y))); }
+int screenY(int x, int y) { return static_cast<int>(std::lround(fl_transform_y(x, y))); }
+
+}  // namespace
+
+bool RenderList::addRectangle(int x, int y, int w, int h, Fl_Color fill, Fl_Color frame)
+{
+    if (!onlyTranslated())
+        return false;
+
+    int sx {screenX(x, y)};
+    int sy {screenY(x, y)};
+    m_fills.push_back({fill, sx, sy, w, h});
+    m_frames.push_back({frame, sx, sy, w+1, h+1});  // lines are drawn on both ends
+    return true;
+}
+
+bool RenderList::addText(const std::string &str, int x, int y, int fontSize, Fl_Color color)
+{
+    if (!onlyTranslated())
+        return false;
+
+    m_labels.push_back({color, fontSize, str, screenX(x, y), screenY(x, y)});
+    return true;
+}
+
+void RenderList::submit()
+{
+    auto byColor {[](const auto &a, const auto &b) { return a.color < b.color; }};
+
+    std::stable_sort(m_fills.begin(), m_fills.end(), byColor);
+    for (std::size_t i = 0; i<m_fills.size(); ++i) {
+        const Rect &r {m_fills[i]};
+        if (i == 0 || r.color != m_fills[i-1].color)
+            fl_color(r.color);
+        fl_rectf(r.x, r.y, r.w, r.h);
+    }
+
+    std::stable_sort(m_frames.begin(), m_frames.end(), byColor);
+    for (std::size_t i = 0; i<m_frames.size(); ++i) {
+        const Rect &r {m_frames[i]};
+        if (i == 0 || r.color != m_frames[i-1].color)
+            fl_color(r.color);
+        fl_rect(r.x, r.y, r.w, r.h);
+    }
+
+    std::stable_sort(m_labels.begin(), m_labels.end(), [](const Label &a, const Label &b) {
+            return a.color < b.color || (a.color == b.color && a.fontSize < b.fontSize);
+            });
+    for (std::size_t i = 0; i<m_labels.size(); ++i) {
+        const Label &l {m_labels[i]};
+        if (i == 0 || l.color != m_labels[i-1].color)
+            fl_color(l.color);
+        if (i == 0 || l.fontSize != m_labels[i-1].fontSize)
+            fl_font(FL_HELVETICA, l.fontSize);
+        fl_draw(l.str.c_str(), l.x, l.y);
+    }
+
+    m_fills.clear();
+    m_frames.clear();
+    m_labels.clear();
+}
@@ -0,0 +1,79 @@
+#ifndef RENDER_LIST_HPP
+#define RENDER_LIST_HPP
+
+#include <FL/Enumerations.H>
+#include <string>
+#include <vector>
+
+/**
+ * Draw commands of a frame, drawn together
+ *
+ * While a Batch is open, rectangles and texts drawn without scaling
+ * or rotation are added to its list instead of being drawn. When
+ * the batch closes, the list is drawn sorted by primitive and colour:
+ * all the fills, then all the frames, then all the texts, changing
+ * the colour only once per colour used. What a single shape draws
+ * keeps its order (e.g. a text over a rectangle), but shapes
+ * overlapping each other shouldn't be drawn in the same batch.
+ *
+ * A list keeps its memory from one frame to the next.
+ */
+class RenderList
+{
+    private:
+        struct Rect
+        {
+            Fl_Color color {0};
+            int x {0};
+            int y {0};
+            int w {0};
+            int h {0};
+        };
+
+        struct Label
+        {
+            Fl_Color color {0};
+            int fontSize {0};
+            std::string str {};
+            int x {0};  // left of the baseline
+            int y {0};
+        };
+
+        std::vector<Rect> m_fills {};
+        std::vector<Rect> m_frames {};
+        std::vector<Label> m_labels {};
+
+        static inline RenderList *m_open {nullptr};
+
+        void submit();
+    public:
+        /// Opens a list for as long as it lives, then draws it
+        class Batch
+        {
+            private:
+                RenderList &m_list;
+                RenderList *m_previous;
+            public:
+                explicit Batch(RenderList &list) : m_list{list}, m_previous{m_open} { m_open = &list; }
+                ~Batch() { m_open = m_previous; m_list.submit(); }
+
+                Batch(const Batch &) = delete;
+                Batch &operator=(const Batch &) = delete;
+        };
+
+        /// The list of the open batch, nullptr if none
+        static RenderList *open() { return m_open; }
+
+        /**
+         * Rectangle from (x, y) to (x+w, y+h), its frame included,
+         * in the coordinates of the current transformation
+         *
+         * @return false, with nothing added, if it isn't only translated
+         */
+        bool addRectangle(int x, int y, int w, int h, Fl_Color fill, Fl_Color frame);
+
+        /// Same as addRectangle, for a text of the given size
+        bool addText(const std::string &str, int x, int y, int fontSize, Fl_Color color);
+};
+
+#endif // RENDER_LIST_HPP
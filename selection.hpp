@@ -0,0 +1,69 @@
+#ifndef SELECTION_HPP
+#define SELECTION_HPP
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+
+#include "point.hpp"
+
+/**
+ * Cells selected by the player, at most two at once
+ *
+ * A swap needs two cells, the selection is emptied as soon as
+ * it is reached. The cells are kept in place, so adding and
+ * removing one is O(1) and never allocates.
+ *
+ * The cells are ordered as in the grid storage (row by row,
+ * from the bottom), whatever the order they were selected in.
+ */
+class Selection
+{
+    public:
+        static constexpr std::size_t capacity {2};
+    private:
+        std::array<Point, capacity> points {};
+        std::size_t count {0};
+
+        static bool before(const Point &a, const Point &b)
+        {
+            return a.y < b.y || (a.y == b.y && a.x < b.x);
+        }
+    public:
+        void add(const Point &p)
+        {
+            assert(count < capacity && !contains(p));
+            std::size_t i {count++};
+            for (; i>0 && before(p, points[i-1]); --i)
+                points[i] = points[i-1];
+            points[i] = p;
+        }
+
+        void remove(const Point &p)
+        {
+            std::size_t i {0};
+            while (i<count && !(points[i] == p))
+                ++i;
+            assert(i < count);
+            for (--count; i<count; ++i)
+                points[i] = points[i+1];
+        }
+
+        bool contains(const Point &p) const
+        {
+            for (std::size_t i = 0; i<count; ++i)
+                if (points[i] == p)
+                    return true;
+            return false;
+        }
+
+        void clear() { count = 0; }
+        bool empty() const { return count == 0; }
+        std::size_t size() const { return count; }
+
+        const Point &at(std::size_t i) const { assert(i < count); return points[i]; }
+        const Point *begin() const { return points.data(); }
+        const Point *end() const { return points.data() + count; }
+};
+
+#endif // SELECTION_HPP
@@ -1,4 +1,11 @@
 #include "shape.hpp"
+#include "render_list.hpp"
+#include "sprite_cache.hpp"
+
+namespace {
+// Shapes drawn from the SpriteCache
+enum SpriteKind : int { StripedSprite, StarSprite, MulticolourSprite };
+}
 
 /*----------------------------------------------------------
  * Rectangle
@@ -33,13 +40,22 @@ Rectangle::Rectangle(
 {}
 
 void Rectangle::draw()
+{
+    RenderList *list {RenderList::open()};
+    if (list && list->addRectangle(center.x - width/2, center.y - height/2,
+                width/2*2, height/2*2, fillColor, frameColor))
+        return;
+    drawRectangle(center);
+}
+
+void Rectangle::drawRectangle(Point c) const
 {
     std::array<Point, 5> points {
-        Point{center.x - width/2, center.y - height/2},
-        Point{center.x - width/2, center.y + height/2},
-        Point{center.x + width/2, center.y + height/2},
-        Point{center.x + width/2, center.y - height/2},
-        Point{center.x - width/2, center.y - height/2}
+        Point{c.x - width/2, c.y - height/2},
+        Point{c.x - width/2, c.y + height/2},
+        Point{c.x + width/2, c.y + height/2},
+        Point{c.x + width/2, c.y - height/2},
+        Point{c.x - width/2, c.y - height/2}
     };
 
     // Fill
@@ -86,26 +102,34 @@ StripedRectangle::StripedRectangle(
 
 void StripedRectangle::draw()
 {
-    Rectangle::draw();
+    SpriteCache::Key key {StripedSprite, fillColor, frameColor, static_cast<int>(axis),
+        width + width/8 + 1, height + height/8 + 1};  // strips stick out by half their width
+    if (!SpriteCache::draw(key, center, [this](Point c) { paint(c); }))
+        paint(center);
+}
+
+void StripedRectangle::paint(Point c) const
+{
+    drawRectangle(c);
     std::array<Point, 6> pointsStrip;
 
     if (axis == Axis::Vertical) {
         pointsStrip = {
-            Point{getCenter().x - width/4, getCenter().y - height/2},
-            Point{getCenter().x - width/4, getCenter().y + height/2},
-            Point{getCenter().x, getCenter().y + height/2},
-            Point{getCenter().x, getCenter().y - height/2},
-            Point{getCenter().x + width/4, getCenter().y - height/2},
-            Point{getCenter().x + width/4, getCenter().y + height/2},
+            Point{c.x - width/4, c.y - height/2},
+            Point{c.x - width/4, c.y + height/2},
+            Point{c.x, c.y + height/2},
+            Point{c.x, c.y - height/2},
+            Point{c.x + width/4, c.y - height/2},
+            Point{c.x + width/4, c.y + height/2},
         };
     } else if (axis == Axis::Horizontal) {
         pointsStrip = {
-            Point{getCenter().x - width/2, getCenter().y - height/4},
-            Point{getCenter().x + width/2, getCenter().y - height/4},
-            Point{getCenter().x + width/2, getCenter().y},
-            Point{getCenter().x - width/2, getCenter().y},
-            Point{getCenter().x - width/2, getCenter().y + height/4},
-            Point{getCenter().x + width/2, getCenter().y + height/4}
+            Point{c.x - width/2, c.y - height/4},
+            Point{c.x + width/2, c.y - height/4},
+            Point{c.x + width/2, c.y},
+            Point{c.x - width/2, c.y},
+            Point{c.x - width/2, c.y + height/4},
+            Point{c.x + width/2, c.y + height/4}
         };
     }
 
@@ -157,15 +181,23 @@ Star::Star(
 {}
 
 void Star::draw()
+{
+    SpriteCache::Key key {StarSprite, fillColor, frameColor, secondPhase,
+        static_cast<int>(width/1.5)*2 + 1, static_cast<int>(height/1.5)*2 + 1};
+    if (!SpriteCache::draw(key, center, [this](Point c) { paint(c); }))
+        paint(center);
+}
+
+void Star::paint(Point c) const
 {
     if (!secondPhase)
-        Rectangle::draw();
+        drawRectangle(c);
     std::array<Point, 5> pointsStar {
-            Point{static_cast<int>(center.x - width/1.5), center.y},
-            Point{center.x, static_cast<int>(center.y + height/1.5)},
-            Point{static_cast<int>(center.x + width/1.5), center.y},
-            Point{center.x, static_cast<int>(center.y - height/1.5)},
-            Point{static_cast<int>(center.x - width/1.5), center.y}
+            Point{static_cast<int>(c.x - width/1.5), c.y},
+            Point{c.x, static_cast<int>(c.y + height/1.5)},
+            Point{static_cast<int>(c.x + width/1.5), c.y},
+            Point{c.x, static_cast<int>(c.y - height/1.5)},
+            Point{static_cast<int>(c.x - width/1.5), c.y}
     };
 
     // Fill
@@ -201,11 +233,16 @@ Circle::Circle(
 {}
 
 void Circle::draw()
+{
+    drawCircle(center);
+}
+
+void Circle::drawCircle(Point c) const
 {
     std::array<Point,37> points;
     for (int i=0; i<36; i++)
-        points[static_cast<unsigned>(i)] = {static_cast<int>(center.x+radius*std::sin(i*10*std::numbers::pi/180)),
-            static_cast<int>(center.y+radius*std::cos(i*10*std::numbers::pi/180))};
+        points[static_cast<unsigned>(i)] = {static_cast<int>(c.x+radius*std::sin(i*10*std::numbers::pi/180)),
+            static_cast<int>(c.y+radius*std::cos(i*10*std::numbers::pi/180))};
     points[36]=points[0];
 
     // Fill
@@ -246,23 +283,31 @@ MulticolourCircle::MulticolourCircle(
 
 void MulticolourCircle::draw()
 {
-    Circle::draw();
+    SpriteCache::Key key {MulticolourSprite, fillColor, frameColor, 0,
+        getRadius()*2 + 1, getRadius()*2 + 1};
+    if (!SpriteCache::draw(key, center, [this](Point c) { paint(c); }))
+        paint(center);
+}
+
+void MulticolourCircle::paint(Point c) const
+{
+    drawCircle(c);
 
     for (int i=0; i<13; i++) {
-        drawRectRotate(i*std::numbers::pi/6, flRelative[i%6]);
+        drawRectRotate(c, i*std::numbers::pi/6, flRelative[i%6]);
     }
 
 }
 
-void MulticolourCircle::drawRectRotate(double angle, Fl_Color fillColor, Fl_Color frameColor)
+void MulticolourCircle::drawRectRotate(Point c, double angle, Fl_Color fillColor, Fl_Color frameColor) const
 {
 
     std::array<Point, 5> points {
-            Point{center.x - (size/4)*sin(angle), center.y + (size/4)*cos(angle)},
-            Point{center.x + (size*cos(angle)-(size/4)*sin(angle)), center.y + (size*sin(angle) + (size/4)*cos(angle))},
-            Point{center.x + (size*cos(angle)+(size/4)*sin(angle)), center.y + (size*sin(angle) - (size/4)*cos(angle))},
-            Point{center.x + (size/4)*sin(angle), center.y - (size/4)*cos(angle)},
-            Point{center.x - (size/4)*sin(angle), center.y + (size/4)*cos(angle)}
+            Point{c.x - (size/4)*sin(angle), c.y + (size/4)*cos(angle)},
+            Point{c.x + (size*cos(angle)-(size/4)*sin(angle)), c.y + (size*sin(angle) + (size/4)*cos(angle))},
+            Point{c.x + (size*cos(angle)+(size/4)*sin(angle)), c.y + (size*sin(angle) - (size/4)*cos(angle))},
+            Point{c.x + (size/4)*sin(angle), c.y - (size/4)*cos(angle)},
+            Point{c.x - (size/4)*sin(angle), c.y + (size/4)*cos(angle)}
     };
 
     // Fill
@@ -300,11 +345,16 @@ Text::Text(
 
 void Text::draw()
 {
-    fl_color(fillColor);
     fl_font(FL_HELVETICA, fontSize);
     int width, height;
     fl_measure(str.c_str(), width, height, false);
-    fl_draw(str.c_str(), center.x-width/2, center.y-fl_descent()+height/2);
+    Point at {center.x-width/2, center.y-fl_descent()+height/2};
+
+    RenderList *list {RenderList::open()};
+    if (list && list->addText(str, at.x, at.y, fontSize, fillColor))
+        return;
+    fl_color(fillColor);
+    fl_draw(str.c_str(), at.x, at.y);
 }
 
 bool Text::contains(const Point& p) const
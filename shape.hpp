@@ -11,6 +11,7 @@
 #include "point.hpp"
 #include "animation.hpp"
 #include "colors.hpp"
+#include "tile.hpp"
 
 class Animation;
 
@@ -63,6 +64,8 @@ class Rectangle : public AnimatableShape
     protected:
         int width;
         int height;
+
+        void drawRectangle(Point c) const;
     public:
         Rectangle(
                 Point center,
@@ -82,19 +85,17 @@ class Rectangle : public AnimatableShape
         void setHeight(int h) { height = h; }
 };
 
-enum class Axis
-{
-    Vertical,
-    Horizontal
-};
-
 /**
  * Striped rectangle
+ *
+ * Drawn from a SpriteCache when possible.
  */
 class StripedRectangle : public Rectangle
 {
     protected:
         Axis axis;
+    private:
+        void paint(Point c) const;
     public:
         StripedRectangle(
                 Point center,
@@ -113,11 +114,14 @@ class StripedRectangle : public Rectangle
 
 /**
  * Star shape for WrappedCandie
+ *
+ * Drawn from a SpriteCache when possible.
  */
 class Star : public Rectangle
 {
     private:
         bool secondPhase{ false };
+        void paint(Point c) const;
 public:
     Star(
             Point center,
@@ -141,6 +145,8 @@ class Circle : public AnimatableShape
 {
     private:
         int radius;
+    protected:
+        void drawCircle(Point c) const;
     public:
         Circle(
                 Point center,
@@ -158,12 +164,15 @@ class Circle : public AnimatableShape
 
 /**
  * MulticolourCircle Shape for colour bomb
+ *
+ * Drawn from a SpriteCache when possible.
  */
 class MulticolourCircle : public Circle
 {
 protected:
     int size;
-    void drawRectRotate(double angle = 0, Fl_Color fillColor = FL_WHITE, Fl_Color frameColor = FL_BLACK);
+    void paint(Point c) const;
+    void drawRectRotate(Point c, double angle = 0, Fl_Color fillColor = FL_WHITE, Fl_Color frameColor = FL_BLACK) const;
 public:
     MulticolourCircle(
             Point center,
@@ -0,0 +1,175 @@
+/*
+ * Plays a level many times without drawing anything
+ * and prints how the games went, to tune the levels.
+ *
+ * Usage: sim.out <level file> [games] [seed] [policy] [threads] [finder]
+ *  - games    number of games to play, 1000 by default
+ *  - seed     seed of the first game, the next ones follow, 1 by default
+ *  - policy   "greedy" (default), "random" or "ranked"
+ *  - threads  number of threads, all the cores by default, the
+ *             ranked policy plays its swaps on as many more
+ *  - finder   "walker" (default) or "bitboard", how combinations are
+ *             found; games are the same with both
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "level_data.hpp"
+#include "simulation.hpp"
+#include "thread_pool.hpp"
+
+namespace {
+
+std::unique_ptr<MovePolicy> makePolicy(const std::string &name, unsigned threads)
+{
+    if (name == "greedy")
+        return std::make_unique<GreedyPolicy>();
+    if (name == "random")
+        return std::make_unique<RandomPolicy>();
+    if (name == "ranked")
+        return std::make_unique<RankedPolicy>(threads);
+    return nullptr;
+}
+
+std::optional<MatchFinder> parseFinder(const std::string &name)
+{
+    if (name == "walker")
+        return MatchFinder::Walker;
+    if (name == "bitboard")
+        return MatchFinder::Bitboard;
+    return std::nullopt;
+}
+
+/// Value under which the given part of the sorted values lie
+int percentile(const std::vector<int> &sorted, double part)
+{
+    auto i {static_cast<std::size_t>(part * static_cast<double>(sorted.size()-1))};
+    return sorted[i];
+}
+
+void printStats(const std::vector<GameResult> &results)
+{
+    std::size_t wins {0};
+    long long totalMoves {0}, winMoves {0}, totalCascades {0};
+    int maxCascades {0}, shuffles {0}, shuffled {0};
+    std::vector<int> scores;
+    std::vector<int> moves;
+    scores.reserve(results.size());
+    moves.reserve(results.size());
+
+    for (auto &r: results) {
+        if (r.won) {
+            ++wins;
+            winMoves += r.moves;
+        }
+        totalMoves += r.moves;
+        totalCascades += r.cascades;
+        maxCascades = std::max(maxCascades, r.maxCascades);
+        shuffles += r.shuffles;
+        if (r.shuffles)
+            ++shuffled;
+        scores.push_back(r.score);
+        moves.push_back(r.moves);
+    }
+    std::sort(scores.begin(), scores.end());
+    std::sort(moves.begin(), moves.end());
+
+    auto mean = [](long long sum, std::size_t count) {
+        return count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0;
+    };
+    long long scoreSum {0};
+    for (auto s: scores)
+        scoreSum += s;
+
+    std::cout << std::fixed << std::setprecision(1)
+        << "Win rate      : " << 100.0*mean(static_cast<long long>(wins), results.size()) << "% ("
+        << wins << "/" << results.size() << ")\n"
+        << "Moves used    : mean " << mean(totalMoves, results.size())
+        << ", mean when won " << mean(winMoves, wins)
+        << ", min " << moves.front() << ", max " << moves.back() << "\n"
+        << "Score         : mean " << mean(scoreSum, scores.size())
+        << ", min " << scores.front()
+        << ", p10 " << percentile(scores, 0.1)
+        << ", p50 " << percentile(scores, 0.5)
+        << ", p90 " << percentile(scores, 0.9)
+        << ", max " << scores.back() << "\n"
+        << std::setprecision(2)
+        << "Cascade depth : mean " << mean(totalCascades, static_cast<std::size_t>(totalMoves))
+        << " per move, max " << maxCascades << "\n"
+        << "Shuffles      : " << shuffles << " in " << shuffled << " games\n";
+}
+
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <level file> [games] [seed] [policy] [threads] [finder]\n";
+        return 1;
+    }
+
+    std::string levelFile {argv[1]};
+    int games {argc > 2 ? std::atoi(argv[2]) : 1000};
+    std::uint64_t seed {argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1};
+    std::string policyName {argc > 4 ? argv[4] : "greedy"};
+    unsigned threads {argc > 5 ? static_cast<unsigned>(std::atoi(argv[5])) : std::thread::hardware_concurrency()};
+    std::string finderName {argc > 6 ? argv[6] : "walker"};
+
+    auto policy {makePolicy(policyName, threads)};
+    if (!policy || games <= 0) {
+        std::cerr << "Unknown policy " << policyName << " or wrong number of games\n";
+        return 1;
+    }
+    auto finder {parseFinder(finderName)};
+    if (!finder) {
+        std::cerr << "Unknown finder " << finderName << "\n";
+        return 1;
+    }
+
+    try {
+        LevelData data {levelFile};
+        LevelSimulation simulation {data, *finder};
+        ThreadPool pool {threads};
+
+        auto start {std::chrono::steady_clock::now()};
+
+        // Games are given by batches, a task per game would cost
+        // more in scheduling than small levels do to play
+        std::vector<GameResult> results(static_cast<std::size_t>(games));
+        std::size_t batch {std::max<std::size_t>(1, results.size() / (pool.size()*8))};
+        std::vector<std::future<void>> done;
+        for (std::size_t first = 0; first<results.size(); first += batch) {
+            std::size_t last {std::min(first+batch, results.size())};
+            done.push_back(pool.submit([&, first, last]() {
+                        for (std::size_t i = first; i<last; ++i)
+                            results[i] = simulation.play(seed+i, *policy);
+                        }));
+        }
+        for (auto &d: done)
+            d.get();
+
+        std::chrono::duration<double> elapsed {std::chrono::steady_clock::now() - start};
+
+        std::cout << "Level " << levelFile << ", " << games << " games, policy "
+            << policy->name() << ", seed " << seed << ", " << pool.size() << " threads, "
+            << finderName << " finder\n";
+        printStats(results);
+        std::cout << std::setprecision(3) << "Time          : " << elapsed.count() << "s ("
+            << std::setprecision(0) << static_cast<double>(games) / elapsed.count() << " games/s)\n";
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,201 @@
+#include "simulation.hpp"
+
+#include <cassert>
+#include <stdexcept>
+
+#include "bitboard.hpp"
+#include "board_engine.hpp"
+#include "candy_generator.hpp"
+#include "level_goal.hpp"
+#include "move_finder.hpp"
+#include "move_ranker.hpp"
+#include "observer.hpp"
+#include "turn_log.hpp"
+
+namespace {
+
+/**
+ * Waits for the goal of the level to say the game is over
+ */
+class GoalWatcher : public Observer
+{
+    public:
+        bool reached {false};
+        bool over {false};
+
+        void update(Event e) override
+        {
+            if (e == Event::GoalReached)
+                reached = over = true;
+            else if (e == Event::NoMoreMoves)
+                over = true;
+        }
+};
+
+/**
+ * Whether the rounds of a turn add up to the turn, each
+ * one being a cascade of the engine
+ */
+[[maybe_unused]] bool isConsistent(const TurnLog &log, int cascades)
+{
+    int score {0};
+    for (auto &r: log.rounds)
+        score += r.score;
+    return score == log.score && static_cast<int>(log.rounds.size()) == cascades;
+}
+
+}  // namespace
+
+std::vector<Move> legalMoves(const Board &board)
+{
+    BitBoard bits {board};
+    MoveFinder finder {bits};
+
+    std::vector<Move> ret;
+    for (int i = 0; i<board.size(); ++i) {
+        Point p {board.pointOf(i)};
+        for (auto &d: {Direction::North, Direction::East}) {
+            if (!board.isIndexValid(p, d))
+                continue;
+
+            Point q {p + directionModifier[static_cast<unsigned>(d)]};
+            const Tile &t {board.at(p)};
+            const Tile &o {board.at(q)};
+            if (!t.isMovable() || !o.isMovable())
+                continue;
+
+            if (BoardEngine::isSpecialSwap(t, o)
+                    || finder.evaluate(p, q).isValid()
+                    || finder.evaluate(q, p).isValid())
+                ret.push_back({p, q});
+        }
+    }
+    return ret;
+}
+
+/*----------------------------------------------------------
+ * Policies
+ *--------------------------------------------------------*/
+
+bool RandomPolicy::choose(const Board &board, Random &random, Move &move) const
+{
+    auto moves {legalMoves(board)};
+    if (moves.empty())
+        return false;
+
+    move = moves[static_cast<std::size_t>(random.below(static_cast<int>(moves.size())))];
+    return true;
+}
+
+bool GreedyPolicy::choose(const Board &board, Random &, Move &move) const
+{
+    for (int i = 0; i<board.size(); ++i) {
+        Point p {board.pointOf(i)};
+        for (auto &d: {Direction::North, Direction::East}) {
+            if (board.isIndexValid(p, d)
+                    && BoardEngine::isSpecialSwap(board.at(p), board.at(p, d))) {
+                move = {p, p + directionModifier[static_cast<unsigned>(d)]};
+                return true;
+            }
+        }
+    }
+
+    BitBoard bits {board};
+    Swap best {MoveFinder{bits}.best()};
+    if (!best.isValid())
+        return false;
+
+    move = {best.from, best.to};
+    return true;
+}
+
+RankedPolicy::RankedPolicy(unsigned threads)
+    : pool{std::make_unique<ThreadPool>(threads)}
+{ }
+
+bool RankedPolicy::choose(const Board &board, Random &random, Move &move) const
+{
+    auto ranked {MoveRanker{*pool, random.nextSeed()}.rank(board)};
+    if (ranked.empty())
+        return false;
+
+    move = {ranked.front().a, ranked.front().b};
+    return true;
+}
+
+/*----------------------------------------------------------
+ * LevelSimulation
+ *--------------------------------------------------------*/
+
+/**
+ * See GridInitState::putInitialContent
+ */
+void LevelSimulation::setUp(Board &board) const
+{
+    for (auto &pos: data.getWallsPos())
+        board.at(pos).type = ContentT::Wall;
+    for (auto &pos: data.getSingleIncingPos()) {
+        board.at(pos).type = ContentT::Icing;
+        board.at(pos).layers = 1;
+    }
+    for (auto &pos: data.getDoubleIcingPos()) {
+        board.at(pos).type = ContentT::Icing;
+        board.at(pos).layers = 2;
+    }
+}
+
+/**
+ * See ReadyState::replaceGrid
+ */
+void LevelSimulation::shuffle(Board &board, Random &random) const
+{
+    CandyGenerator generator {board, random};
+    if (!generator.shuffle())
+        generator.recolor();
+}
+
+GameResult LevelSimulation::play(std::uint64_t seed, const MovePolicy &policy) const
+{
+    auto goal {data.makeGoal()};
+    if (!goal)
+        throw std::runtime_error{"LevelSimulation: Goal of " + data.levelName() + " can't be simulated"};
+
+    Random random {seed};
+    Board board {data.getGridSize(), data.getGridSize(), data.getColorRange()};
+    setUp(board);
+
+    BoardEngine engine {board, random.nextSeed()};
+    engine.setMatchFinder(finder);
+    engine.fillEmptyCells();
+    GoalWatcher watcher;
+    engine.registerObserver(goal.get());
+    goal->registerObserver(&watcher);
+
+    GameResult ret;
+    while (!watcher.over) {
+        Move move;
+        if (!policy.choose(board, random, move)) {
+            if (ret.shuffles == maxShuffles)
+                break;
+            ++ret.shuffles;
+            shuffle(board, random);
+            continue;
+        }
+
+        TurnLog log {engine.resolveTurn(move.a, move.b)};
+        if (!log.valid)
+            throw std::logic_error{"LevelSimulation: Policy " + policy.name() + " chose an illegal move"};
+        assert(!BitBoard{board}.hasCombination());  // see BoardEngine::fallEnd
+        assert(isConsistent(log, engine.cascades()));
+
+        const int cascades {static_cast<int>(log.rounds.size())};
+        ++ret.moves;
+        ret.cascades += cascades;
+        if (cascades > ret.maxCascades)
+            ret.maxCascades = cascades;
+    }
+
+    ret.won = watcher.reached;
+    ret.score = engine.score();
+    return ret;
+}
@@ -0,0 +1,126 @@
+#ifndef SIMULATION_HPP
+#define SIMULATION_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bitboard.hpp"
+#include "board.hpp"
+#include "level_data.hpp"
+#include "point.hpp"
+#include "random.hpp"
+#include "thread_pool.hpp"
+
+/**
+ * Two cells to swap, b being the one selected last
+ */
+struct Move
+{
+    Point a {0, 0};
+    Point b {0, 0};
+};
+
+/**
+ * Swaps of the board that the engine would accept
+ */
+std::vector<Move> legalMoves(const Board &board);
+
+/**
+ * How a simulated player picks its moves
+ *
+ * Policies must not keep any state, the same policy
+ * is used by every game, from every thread.
+ */
+class MovePolicy
+{
+    public:
+        virtual ~MovePolicy() noexcept = default;
+
+        virtual std::string name() const = 0;
+
+        /**
+         * @return whether a move was chosen
+         */
+        virtual bool choose(const Board &board, Random &random, Move &move) const = 0;
+};
+
+/// Any legal move
+class RandomPolicy : public MovePolicy
+{
+    public:
+        std::string name() const override { return "random"; }
+        bool choose(const Board &board, Random &random, Move &move) const override;
+};
+
+/// Special candies first, then the biggest combination, like the hint
+class GreedyPolicy : public MovePolicy
+{
+    public:
+        std::string name() const override { return "greedy"; }
+        bool choose(const Board &board, Random &random, Move &move) const override;
+};
+
+/**
+ * The move whose whole turn scores the most, see MoveRanker
+ *
+ * The swaps are played on threads of their own, games waiting
+ * for them on the threads of another pool can't starve them.
+ *
+ * @param threads number of threads playing the swaps
+ */
+class RankedPolicy : public MovePolicy
+{
+    private:
+        std::unique_ptr<ThreadPool> pool;
+    public:
+        explicit RankedPolicy(unsigned threads);
+
+        std::string name() const override { return "ranked"; }
+        bool choose(const Board &board, Random &random, Move &move) const override;
+};
+
+/**
+ * What happened during one game
+ */
+struct GameResult
+{
+    bool won {false};
+    int moves {0};          // moves played
+    int score {0};
+    int cascades {0};       // clear and fall rounds, all moves together
+    int maxCascades {0};    // most rounds in a single move
+    int shuffles {0};       // times the board had no move left
+};
+
+/**
+ * Plays a level without drawing anything
+ *
+ * The board is set up like GridInitState does, then moves
+ * are played by a BoardEngine until the goal of the level is
+ * reached or no move is left. A game only depends on its seed,
+ * whichever MatchFinder the engine uses.
+ *
+ * @param data the level to play
+ * @param finder how the engine looks for combinations
+ */
+class LevelSimulation
+{
+    private:
+        const LevelData &data;
+        MatchFinder finder;
+
+        static constexpr int maxShuffles {100};
+
+        void setUp(Board &board) const;
+        void shuffle(Board &board, Random &random) const;
+    public:
+        explicit LevelSimulation(const LevelData &data, MatchFinder finder = MatchFinder::Walker) noexcept
+            : data{data}, finder{finder}
+        { }
+
+        GameResult play(std::uint64_t seed, const MovePolicy &policy) const;
+};
+
+#endif // SIMULATION_HPP
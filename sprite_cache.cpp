@@ -0,0 +1,70 @@
+#include "sprite_cache.hpp"
+
+#include <FL/fl_draw.H>
+#include <FL/x.H>  // offscreens
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#include "animation.hpp"
+
+/*----------------------------------------------------------
+ * SpriteCache
+ *--------------------------------------------------------*/
+
+bool SpriteCache::draw(const Key &key, Point center, const Paint &paint)
+{
+    // Only a translation leaves a picture as it is
+    if (!onlyTranslated())
+        return false;
+
+    auto &sprite {m_sprites[key]};
+    if (!sprite)
+        sprite = make(key, paint);
+
+    int x {static_cast<int>(std::lround(fl_transform_x(center.x, center.y)))};
+    int y {static_cast<int>(std::lround(fl_transform_y(center.x, center.y)))};
+    sprite->draw(x - sprite->w()/2, y - sprite->h()/2);
+    return true;
+}
+
+/**
+ * Paints the shape twice, on black then on white: the pixels
+ * that differ are the background, the others are the shape
+ */
+std::unique_ptr<Fl_RGB_Image> SpriteCache::make(const Key &key, const Paint &paint)
+{
+    int w {key.width + 2*margin};
+    int h {key.height + 2*margin};
+
+    // Shapes are drawn through the current translation, which is undone
+    Point offset {static_cast<int>(std::lround(fl_transform_x(0, 0))),
+                  static_cast<int>(std::lround(fl_transform_y(0, 0)))};
+    Point center {Point{w/2, h/2} - offset};
+
+    std::array<std::unique_ptr<uchar[]>, 2> shots;
+    Fl_Offscreen buffer {fl_create_offscreen(w, h)};
+    fl_begin_offscreen(buffer);
+    for (std::size_t i = 0; i<shots.size(); ++i) {
+        fl_rectf(0, 0, w, h, i == 0 ? FL_BLACK : FL_WHITE);
+        paint(center);
+        shots[i].reset(fl_read_image(nullptr, 0, 0, w, h));
+    }
+    fl_end_offscreen();
+    fl_delete_offscreen(buffer);
+
+    std::size_t pixels {static_cast<std::size_t>(w*h)};
+    std::unique_ptr<uchar[]> rgba {new uchar[pixels*4]};
+    for (std::size_t p = 0; p<pixels; ++p) {
+        const uchar *onBlack {&shots[0][p*3]};
+        const uchar *onWhite {&shots[1][p*3]};
+        std::copy(onBlack, onBlack+3, &rgba[p*4]);
+        rgba[p*4 + 3] = std::equal(onBlack, onBlack+3, onWhite) ? 255 : 0;
+    }
+
+    auto ret {std::make_unique<Fl_RGB_Image>(rgba.get(), w, h, 4)};
+    ret->alloc_array = 1;  // the picture now owns rgba
+    rgba.release();
+    return ret;
+}
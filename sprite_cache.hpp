@@ -0,0 +1,64 @@
+#ifndef SPRITE_CACHE_HPP
+#define SPRITE_CACHE_HPP
+
+#include <FL/Enumerations.H>
+#include <FL/Fl_Image.H>
+#include <compare>
+#include <functional>
+#include <map>
+#include <memory>
+
+#include "point.hpp"
+
+/**
+ * Pictures of shapes, made once and copied on the screen
+ *
+ * Some shapes (e.g. the ones of special candies) take many drawing
+ * calls. The first time one is drawn with a given look, it is drawn
+ * in an offscreen buffer and kept as a picture. Later draws are a
+ * single copy of that picture. Parts of the picture the shape doesn't
+ * cover are transparent.
+ *
+ * Pictures are copied as they are, so shapes that are scaled or
+ * rotated (e.g. by an animation) are drawn as usual. The cache is
+ * to be cleared when the pictures no longer fit the screen, e.g.
+ * when the window is resized.
+ */
+class SpriteCache
+{
+    public:
+        /// Everything that makes a picture look the way it does
+        struct Key
+        {
+            int kind {0};        // which shape, up to the shapes
+            Fl_Color fill {0};
+            Fl_Color frame {0};
+            int variant {0};     // e.g. axis of the stripes
+            int width {0};       // part of the screen the shape covers
+            int height {0};
+
+            auto operator<=>(const Key &) const = default;
+        };
+
+        /// Draws the shape centered on the given point
+        using Paint = std::function<void(Point center)>;
+    private:
+        static constexpr int margin {2};  // around the shape, for its frame
+
+        static inline std::map<Key, std::unique_ptr<Fl_RGB_Image>> m_sprites {};
+
+        static std::unique_ptr<Fl_RGB_Image> make(const Key &key, const Paint &paint);
+    public:
+        /**
+         * Draws the picture of key centered on center, painted
+         * the first time it is needed
+         *
+         * @return false, with nothing drawn, if the current
+         *         transformation can't be applied to a picture
+         */
+        static bool draw(const Key &key, Point center, const Paint &paint);
+
+        static void clear() { m_sprites.clear(); }
+};
+
+#endif // SPRITE_CACHE_HPP
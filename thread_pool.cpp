@@ -0,0 +1,104 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+namespace {
+
+// Pool and queue of the current thread, if it is a worker
+thread_local const void *currentPool {nullptr};
+thread_local std::size_t currentWorker {0};
+
+}  // namespace
+
+/*----------------------------------------------------------
+ * ThreadPool
+ *--------------------------------------------------------*/
+
+ThreadPool::ThreadPool(unsigned threads)
+{
+    std::size_t count {std::max(threads, 1u)};
+    for (std::size_t i = 0; i<count; ++i)
+        queues.push_back(std::make_unique<Queue>());
+    for (std::size_t i = 0; i<count; ++i)
+        workers.emplace_back([this, i]() { run(i); });
+}
+
+/**
+ * Waits for the queued tasks to be done
+ */
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock {sleepMutex};
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto &w: workers)
+        w.join();
+}
+
+void ThreadPool::push(std::function<void()> task)
+{
+    std::size_t q {currentPool == this
+        ? currentWorker
+        : nextQueue.fetch_add(1) % queues.size()};
+    {
+        // Counted before it can be taken, pending never goes below 0
+        std::lock_guard<std::mutex> lock {queues[q]->mutex};
+        ++pending;
+        queues[q]->tasks.push_back(std::move(task));
+    }
+    {
+        // So that a worker can't miss the wake up between
+        // checking pending and going to sleep
+        std::lock_guard<std::mutex> lock {sleepMutex};
+    }
+    wake.notify_one();
+}
+
+/**
+ * Takes a task for the given worker, from its own queue
+ * first, then from the others
+ *
+ * @return whether a task was found
+ */
+bool ThreadPool::pop(std::size_t worker, std::function<void()> &task)
+{
+    for (std::size_t i = 0; i<queues.size(); ++i) {
+        Queue &q {*queues[(worker+i) % queues.size()]};
+        std::lock_guard<std::mutex> lock {q.mutex};
+        if (q.tasks.empty())
+            continue;
+
+        if (i == 0) {
+            task = std::move(q.tasks.back());
+            q.tasks.pop_back();
+        } else {
+            task = std::move(q.tasks.front());
+            q.tasks.pop_front();
+        }
+        --pending;
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::run(std::size_t worker)
+{
+    currentPool = this;
+    currentWorker = worker;
+
+    std::function<void()> task;
+    while (true) {
+        if (pop(worker, task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock {sleepMutex};
+        wake.wait(lock, [this]() { return stopping || pending > 0; });
+        if (stopping && pending == 0)
+            return;
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Fixed set of threads running submitted tasks
+ *
+ * Each worker has its own queue. Tasks submitted from outside are
+ * spread over the queues, tasks submitted by a worker go to its own
+ * queue. A worker takes the most recent task of its queue and, when
+ * it is empty, steals the oldest task of another one, so uneven
+ * tasks (e.g. a move with a long cascade) don't leave cores idle.
+ *
+ * @param threads number of workers, at least one
+ */
+class ThreadPool
+{
+    private:
+        struct Queue
+        {
+            std::mutex mutex {};
+            std::deque<std::function<void()>> tasks {};
+        };
+
+        std::vector<std::unique_ptr<Queue>> queues {};
+        std::vector<std::thread> workers {};
+
+        std::mutex sleepMutex {};
+        std::condition_variable wake {};
+        std::atomic<std::size_t> pending {0};  // tasks queued and not taken yet
+        std::atomic<std::size_t> nextQueue {0};
+        bool stopping {false};
+
+        void push(std::function<void()> task);
+        bool pop(std::size_t worker, std::function<void()> &task);
+        void run(std::size_t worker);
+    public:
+        explicit ThreadPool(unsigned threads = std::thread::hardware_concurrency());
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        std::size_t size() const { return workers.size(); }
+
+        /**
+         * Runs f on one of the workers
+         *
+         * @return the future result of f
+         */
+        template<typename F>
+        std::future<std::invoke_result_t<F>> submit(F f)
+        {
+            using R = std::invoke_result_t<F>;
+            auto task {std::make_shared<std::packaged_task<R()>>(std::move(f))};
+            std::future<R> ret {task->get_future()};
+            push([task]() { (*task)(); });
+            return ret;
+        }
+};
+
+#endif // THREAD_POOL_HPP
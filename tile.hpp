@@ -0,0 +1,103 @@
+#ifndef TILE_HPP
+#define TILE_HPP
+
+#include <cstdint>
+
+/**
+ * Kinds of content that can be put on a cell
+ *
+ * Empty is used by the board model for cells
+ * without any content.
+ */
+enum class ContentT : std::uint8_t {
+    Empty,
+    StandardCandy,
+    StripedCandy,
+    WrappedCandy,
+    ColourBomb,
+    Wall,
+    Icing
+};
+
+// This is different than FL colors
+// because only these are permitted.
+enum class CandyColor : std::uint8_t {
+    Blue,
+    Green,
+    Cyan,
+    Magenta,
+    Red,
+    Yellow
+};
+
+enum class Axis : std::uint8_t
+{
+    Vertical,
+    Horizontal
+};
+
+/**
+ * Plain description of what lies on a cell, without any drawing
+ *
+ * This is what the board model works on, a grid of tiles
+ * is enough to play the game logic without FLTK.
+ *
+ * The flags are bookkeeping of the clearing process and
+ * have no meaning outside of a BoardEngine, except Clearing
+ * which the Grid also mirrors.
+ */
+struct Tile
+{
+    enum Flag : std::uint8_t {
+        Clearing      = 1 << 0,  // will be removed at the end of the clear
+        Armed         = 1 << 1,  // wrapped candy waiting for its second explosion
+        DoubleWrapped = 1 << 2,  // wrapped candy swapped with another wrapped
+        Processed     = 1 << 3   // already part of a combination this clear
+    };
+
+    ContentT type {ContentT::Empty};
+    CandyColor color {CandyColor::Blue};
+    Axis axis {Axis::Vertical};
+    std::uint8_t layers {0};     // icing only
+    std::uint8_t flags {0};
+
+    bool isEmpty() const { return type == ContentT::Empty; }
+
+    bool isCandy() const
+    {
+        return type == ContentT::StandardCandy
+            || type == ContentT::StripedCandy
+            || type == ContentT::WrappedCandy;
+    }
+
+    bool isMovable() const { return isCandy() || type == ContentT::ColourBomb; }
+    bool isMatchable() const { return isCandy(); }
+    bool isClearable() const { return !isEmpty() && type != ContentT::Wall; }
+    bool isStatic() const { return type == ContentT::Wall; }  // never changes once put
+
+    bool isSpecial() const
+    {
+        return type == ContentT::StripedCandy
+            || type == ContentT::WrappedCandy
+            || type == ContentT::ColourBomb;
+    }
+
+    bool has(Flag f) const { return flags & f; }
+    void set(Flag f) { flags = static_cast<std::uint8_t>(flags | f); }
+    void unset(Flag f) { flags = static_cast<std::uint8_t>(flags & ~f); }
+
+    /// Whether both tiles describe the same content, flags aside
+    bool sameContent(const Tile &other) const
+    {
+        return type == other.type && color == other.color
+            && axis == other.axis && layers == other.layers;
+    }
+
+    /// Whether both tiles are candies of the same color
+    bool matches(const Tile &other) const
+    {
+        return isMatchable() && other.isMatchable() && color == other.color;
+    }
+};
+
+#endif // TILE_HPP
@@ -0,0 +1,36 @@
+#include "turn_check.hpp"
+
+#include "board_engine.hpp"
+
+/*----------------------------------------------------------
+ * TurnCheck
+ *--------------------------------------------------------*/
+
+void TurnCheck::begin(const Board &board, const Random &random, const Point &a, const Point &b, int score)
+{
+    m_before = board;
+    m_random = random;
+    m_a = a;
+    m_b = b;
+    m_score = score;
+}
+
+/**
+ * Only the contents are compared, the flags are bookkeeping
+ * of the clears that the Grid doesn't keep
+ */
+bool TurnCheck::matches(const Board &board, int score) const
+{
+    Board played {m_before};
+    BoardEngine engine {played, m_random};
+    engine.playMove(m_a, m_b);
+
+    if (m_score + engine.score() != score)
+        return false;
+    for (int i = 0; i<board.size(); ++i) {
+        const Point p {board.pointOf(i)};
+        if (!played.at(p).sameContent(board.at(p)))
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,47 @@
+#ifndef TURN_CHECK_HPP
+#define TURN_CHECK_HPP
+
+#include "board.hpp"
+#include "point.hpp"
+#include "random.hpp"
+
+/**
+ * Plays a turn of the Grid again on a BoardEngine
+ *
+ * The rules are written twice: once in BoardEngine, which is the
+ * reference, and once in the states and the contents, which play
+ * them on the Grid with animations. Both must end a turn on the
+ * same board with the same score when they start from the same
+ * board and move and draw from the same random generator.
+ *
+ * The level begins a check when the player swaps two candies and
+ * asserts it once the turn is over, before the board is shuffled.
+ *
+ * @param board any board of the level, to size the copies
+ */
+class TurnCheck
+{
+    private:
+        Board m_before;
+        Random m_random {};
+        Point m_a {0, 0};
+        Point m_b {0, 0};  // the cell selected last
+        int m_score {0};
+    public:
+        explicit TurnCheck(const Board &board)
+            : m_before{board}
+        { }
+
+        /**
+         * A turn begins, before a and b are swapped
+         *
+         * @param random the generator the turn draws from
+         * @param score the score of the level
+         */
+        void begin(const Board &board, const Random &random, const Point &a, const Point &b, int score);
+
+        /// Whether the engine ends the turn on that board with that score
+        bool matches(const Board &board, int score) const;
+};
+
+#endif // TURN_CHECK_HPP
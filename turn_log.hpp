@@ -0,0 +1,55 @@
+#ifndef TURN_LOG_HPP
+#define TURN_LOG_HPP
+
+#include <vector>
+
+#include "gravity.hpp"
+#include "point.hpp"
+#include "tile.hpp"
+
+/**
+ * Everything that happened during a turn, see BoardEngine::resolveTurn
+ *
+ * A turn is made of rounds, each one being what the Grid goes
+ * through from a ClearState to the end of the next FallState:
+ * contents are cleared, then what is above falls and new candies
+ * come in. The first round starts with the swap, the next ones
+ * with the combinations the fall made.
+ *
+ * Replaying the rounds in order, with their animations, gives
+ * the same board as the one the engine ended on.
+ */
+struct TurnLog
+{
+    /// A special candy put on the board
+    struct Special
+    {
+        Point at {0, 0};
+        Tile tile {};
+    };
+
+    struct Round
+    {
+        std::vector<Point> cleared {};       // contents cleared, in the order they were
+        std::vector<Special> created {};     // special candies made by combinations or effects
+        std::vector<Point> icingRemoved {};  // one entry per layer of icing removed
+        std::vector<Fall> falls {};          // once the cleared contents are removed
+        int score {0};
+    };
+
+    Point a {0, 0};
+    Point b {0, 0};     // the cell selected last
+    bool valid {false};  // whether the swap was kept
+    std::vector<Round> rounds {};
+    int score {0};
+
+    std::size_t clearedCount() const
+    {
+        std::size_t ret {0};
+        for (auto &r: rounds)
+            ret += r.cleared.size();
+        return ret;
+    }
+};
+
+#endif // TURN_LOG_HPP